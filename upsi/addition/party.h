@@ -40,6 +40,7 @@ class Party : public HasTree<P, E> {
 
             decrypter = std::make_unique<ElGamalDecrypter>(
                 this->ctx_,
+                this->group,
                 elgamal_proto_util::DeserializePrivateKey(this->ctx_, esk.value()).value()
             );
 
@@ -1,17 +1,62 @@
 #include "upsi/addition/party_one.h"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
 #include "absl/memory/memory.h"
 
 #include "upsi/crypto/ec_point_util.h"
 #include "upsi/crypto/elgamal.h"
 #include "upsi/roles.h"
 #include "upsi/util/elgamal_proto_util.h"
+#include "upsi/util/parallel.h"
 #include "upsi/util/proto_util.h"
 #include "upsi/utils.h"
 
 namespace upsi {
 namespace addonly {
 
+namespace {
+
+// smallest number of candidates worth handing to a worker thread
+constexpr size_t MIN_CANDIDATE_CHUNK = 16;
+
+/**
+ * the shuffle + mask + partial decrypt + serialize stage of every
+ * GenerateMessageII: draws a random permutation of the candidate
+ * indices and fills out[i] with process(candidates[pi(i)]), running
+ * over chunks of the outgoing message on worker threads in one pass
+ *
+ * the candidates themselves are never moved
+ */
+template<typename T>
+Status ShuffleAndProcess(
+    std::vector<T>& candidates,
+    google::protobuf::RepeatedPtrField<EncryptedElement>* out,
+    const std::function<Status(T&, EncryptedElement*)>& process
+) {
+    std::vector<size_t> order(candidates.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), *ContextPool::GetDrbg());
+
+    size_t first = out->size();
+    out->Reserve(first + candidates.size());
+    for (size_t i = 0; i < candidates.size(); i++) { out->Add(); }
+
+    return ParallelFor(
+        candidates.size(), MIN_CANDIDATE_CHUNK,
+        [&](size_t begin, size_t end) -> Status {
+            for (size_t i = begin; i < end; i++) {
+                RETURN_IF_ERROR(process(candidates[order[i]], out->Mutable(first + i)));
+            }
+            return OkStatus();
+        }
+    );
+}
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 // HANDLE
 ////////////////////////////////////////////////////////////////////////////////
@@ -147,40 +192,31 @@ StatusOr<PartyOneMessage::MessageII> PartyOnePSI::GenerateMessageII(
         }
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::shuffle(candidates.begin(), candidates.end(), gen);
-
-    for (size_t i = 0; i < candidates.size(); i++) {
-        BigNum alpha = this->encrypter->CreateRandomMask();
-        BigNum beta = this->encrypter->CreateRandomMask();
-        ASSIGN_OR_RETURN(
-            candidates[i].first,
-            elgamal::Exp(candidates[i].first, alpha)
-        );
-        ASSIGN_OR_RETURN(
-            Ciphertext mask,
-            elgamal::Exp(candidates[i].first, beta)
-        );
-        ASSIGN_OR_RETURN(
-            candidates[i].second,
-            elgamal::Mul(candidates[i].second, mask)
-        );
-    }
-
-    for (size_t i = 0; i < candidates.size(); i++) {
-        auto candidate = response.mutable_candidates()->add_elements();
-        ASSIGN_OR_RETURN(candidates[i].first, decrypter->PartialDecrypt(candidates[i].first));
-        ASSIGN_OR_RETURN(candidates[i].second, decrypter->PartialDecrypt(candidates[i].second));
-        ASSIGN_OR_RETURN(
-            *candidate->mutable_elgamal()->mutable_element(),
-            elgamal_proto_util::SerializeCiphertext(candidates[i].first)
-        );
-        ASSIGN_OR_RETURN(
-            *candidate->mutable_elgamal()->mutable_payload(),
-            elgamal_proto_util::SerializeCiphertext(candidates[i].second)
-        );
-    }
+    const BigNum& order = this->group->GetOrder();
+    RETURN_IF_ERROR(ShuffleAndProcess<CiphertextAndElGamal>(
+        candidates, response.mutable_candidates()->mutable_elements(),
+        [&](CiphertextAndElGamal& candidate, EncryptedElement* out) -> Status {
+            BigNum alpha = this->encrypter->CreateRandomMask();
+            BigNum beta = this->encrypter->CreateRandomMask();
+            ASSIGN_OR_RETURN(
+                Ciphertext mask, elgamal::Exp(candidate.first, alpha.ModMul(beta, order))
+            );
+            ASSIGN_OR_RETURN(Ciphertext payload, elgamal::Mul(candidate.second, mask));
+            ASSIGN_OR_RETURN(payload, decrypter->PartialDecrypt(payload));
+            ASSIGN_OR_RETURN(
+                Ciphertext element, decrypter->MaskAndPartialDecrypt(candidate.first, alpha)
+            );
+            ASSIGN_OR_RETURN(
+                *out->mutable_elgamal()->mutable_element(),
+                elgamal_proto_util::SerializeCiphertext(element)
+            );
+            ASSIGN_OR_RETURN(
+                *out->mutable_elgamal()->mutable_payload(),
+                elgamal_proto_util::SerializeCiphertext(payload)
+            );
+            return OkStatus();
+        }
+    ));
 
     // update our tree
     RETURN_IF_ERROR(my_tree.Update(
@@ -222,26 +258,20 @@ StatusOr<PartyOneMessage::MessageII> PartyOneCardinality::GenerateMessageII(
         }
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::shuffle(candidates.begin(), candidates.end(), gen);
-
-    for (size_t i = 0; i < candidates.size(); i++) {
-        BigNum mask = this->encrypter->CreateRandomMask();
-        ASSIGN_OR_RETURN(
-            candidates[i],
-            elgamal::Exp(candidates[i], mask)
-        );
-    }
-
-    for (size_t i = 0; i < candidates.size(); i++) {
-        auto candidate = response.mutable_candidates()->add_elements();
-        ASSIGN_OR_RETURN(candidates[i], decrypter->PartialDecrypt(candidates[i]));
-        ASSIGN_OR_RETURN(
-            *candidate->mutable_no_payload()->mutable_element(),
-            elgamal_proto_util::SerializeCiphertext(candidates[i])
-        );
-    }
+    RETURN_IF_ERROR(ShuffleAndProcess<Ciphertext>(
+        candidates, response.mutable_candidates()->mutable_elements(),
+        [&](Ciphertext& candidate, EncryptedElement* out) -> Status {
+            BigNum mask = this->encrypter->CreateRandomMask();
+            ASSIGN_OR_RETURN(
+                Ciphertext element, decrypter->MaskAndPartialDecrypt(candidate, mask)
+            );
+            ASSIGN_OR_RETURN(
+                *out->mutable_no_payload()->mutable_element(),
+                elgamal_proto_util::SerializeCiphertext(element)
+            );
+            return OkStatus();
+        }
+    ));
 
     // update our tree
     RETURN_IF_ERROR(my_tree.Update(
@@ -287,31 +317,25 @@ StatusOr<PartyOneMessage::MessageII> PartyOneSum::GenerateMessageII(
         }
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::shuffle(candidates.begin(), candidates.end(), gen);
-
-    for (size_t i = 0; i < candidates.size(); i++) {
-        BigNum mask = this->encrypter->CreateRandomMask();
-        ASSIGN_OR_RETURN(
-            candidates[i].first,
-            elgamal::Exp(candidates[i].first, mask)
-        );
-    }
-
-    for (size_t i = 0; i < candidates.size(); i++) {
-        auto candidate = response.mutable_candidates()->add_elements();
-        ASSIGN_OR_RETURN(candidates[i].first, decrypter->PartialDecrypt(candidates[i].first));
-        ASSIGN_OR_RETURN(
-            *candidate->mutable_elgamal()->mutable_element(),
-            elgamal_proto_util::SerializeCiphertext(candidates[i].first)
-        );
-        ASSIGN_OR_RETURN(Ciphertext randomized, encrypter->ReRandomize(candidates[i].second));
-        ASSIGN_OR_RETURN(
-            *candidate->mutable_elgamal()->mutable_payload(),
-            elgamal_proto_util::SerializeCiphertext(randomized)
-        );
-    }
+    RETURN_IF_ERROR(ShuffleAndProcess<CiphertextAndElGamal>(
+        candidates, response.mutable_candidates()->mutable_elements(),
+        [&](CiphertextAndElGamal& candidate, EncryptedElement* out) -> Status {
+            BigNum mask = this->encrypter->CreateRandomMask();
+            ASSIGN_OR_RETURN(
+                Ciphertext element, decrypter->MaskAndPartialDecrypt(candidate.first, mask)
+            );
+            ASSIGN_OR_RETURN(
+                *out->mutable_elgamal()->mutable_element(),
+                elgamal_proto_util::SerializeCiphertext(element)
+            );
+            ASSIGN_OR_RETURN(Ciphertext randomized, encrypter->ReRandomize(candidate.second));
+            ASSIGN_OR_RETURN(
+                *out->mutable_elgamal()->mutable_payload(),
+                elgamal_proto_util::SerializeCiphertext(randomized)
+            );
+            return OkStatus();
+        }
+    ));
 
     // update our tree
     RETURN_IF_ERROR(my_tree.Update(
@@ -380,28 +404,22 @@ StatusOr<PartyOneMessage::MessageII> PartyOneSecretShare::GenerateMessageII(
         }
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::shuffle(candidates.begin(), candidates.end(), gen);
-
-    for (size_t i = 0; i < candidates.size(); i++) {
-        BigNum mask = this->encrypter->CreateRandomMask();
-        ASSIGN_OR_RETURN(
-            candidates[i].first,
-            elgamal::Exp(candidates[i].first, mask)
-        );
-    }
-
-    for (size_t i = 0; i < candidates.size(); i++) {
-        auto candidate = response.mutable_candidates()->add_elements();
-        ASSIGN_OR_RETURN(candidates[i].first, decrypter->PartialDecrypt(candidates[i].first));
-        ASSIGN_OR_RETURN(
-            *candidate->mutable_paillier()->mutable_element(),
-            elgamal_proto_util::SerializeCiphertext(candidates[i].first)
-        );
-        ASSIGN_OR_RETURN(BigNum randomized, this->paillier->ReRand(candidates[i].second));
-        *candidate->mutable_paillier()->mutable_payload() = randomized.ToBytes();
-    }
+    RETURN_IF_ERROR(ShuffleAndProcess<CiphertextAndPaillier>(
+        candidates, response.mutable_candidates()->mutable_elements(),
+        [&](CiphertextAndPaillier& candidate, EncryptedElement* out) -> Status {
+            BigNum mask = this->encrypter->CreateRandomMask();
+            ASSIGN_OR_RETURN(
+                Ciphertext element, decrypter->MaskAndPartialDecrypt(candidate.first, mask)
+            );
+            ASSIGN_OR_RETURN(
+                *out->mutable_paillier()->mutable_element(),
+                elgamal_proto_util::SerializeCiphertext(element)
+            );
+            ASSIGN_OR_RETURN(BigNum randomized, this->paillier->ReRand(candidate.second));
+            *out->mutable_paillier()->mutable_payload() = randomized.ToBytes();
+            return OkStatus();
+        }
+    ));
 
     // update our tree
     RETURN_IF_ERROR(my_tree.Update(
@@ -414,14 +432,16 @@ StatusOr<PartyOneMessage::MessageII> PartyOneSecretShare::GenerateMessageII(
 Status PartyOneSecretShare::ProcessMessageIII(
     const PartyZeroMessage::MessageIII_SS& msg
 ) {
-    for (auto i = 0; i < msg.payloads().size(); i += 2) {
-        ASSIGN_OR_RETURN(
-            BigNum share, this->paillier->Decrypt(
-                this->ctx_->CreateBigNum(msg.payloads().at(i).ciphertext()),
-                this->ctx_->CreateBigNum(msg.payloads().at(i + 1).ciphertext())
-            )
-        );
-        shares.push_back(share);
+    std::vector<BigNum> ciphertexts;
+    std::vector<BigNum> partials;
+    for (auto i = 0; i + 1 < msg.payloads().size(); i += 2) {
+        ciphertexts.push_back(this->ctx_->CreateBigNum(msg.payloads().at(i).ciphertext()));
+        partials.push_back(this->ctx_->CreateBigNum(msg.payloads().at(i + 1).ciphertext()));
+    }
+
+    ASSIGN_OR_RETURN(std::vector<BigNum> decrypted, this->paillier->DecryptBatch(ciphertexts, partials));
+    for (BigNum& share : decrypted) {
+        shares.push_back(std::move(share));
     }
 
     return OkStatus();
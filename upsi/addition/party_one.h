@@ -132,6 +132,9 @@ class PartyOneSecretShare : public Party<Element, CiphertextAndPaillier>, public
         PartyOneSecretShare(PSIParams* params, const std::vector<Dataset>& datasets) :
             Party<Element, CiphertextAndPaillier>(params), PartyOne(params, datasets)
         {
+            if (params->paillier_pool > 0) {
+                this->paillier->StartBackgroundRandomness(params->paillier_pool);
+            }
             if (params->start_size > 0) {
                 auto status = CreateMockTrees(params->start_size);
                 if (!status.ok()) {
@@ -1,5 +1,9 @@
 #include "upsi/addition/party_zero.h"
 
+#include <functional>
+#include <mutex>
+#include <optional>
+
 #include "absl/memory/memory.h"
 
 #include "upsi/network/connection.h"
@@ -8,12 +12,133 @@
 #include "upsi/roles.h"
 #include "upsi/util/data_util.h"
 #include "upsi/util/elgamal_proto_util.h"
+#include "upsi/util/parallel.h"
 #include "upsi/util/proto_util.h"
 #include "upsi/utils.h"
 
 namespace upsi {
 namespace addonly {
 
+namespace {
+
+// smallest number of new elements worth handing to a worker thread
+constexpr size_t MIN_ELEMENT_CHUNK = 4;
+
+// smallest number of received candidates worth handing to a worker thread
+constexpr size_t MIN_RECEIVED_CHUNK = 16;
+
+/**
+ * returns the element field of whichever kind of candidate this is
+ */
+ElGamalCiphertext* MutableCandidateElement(EncryptedElement* candidate) {
+    switch (candidate->element_type_case()) {
+        case EncryptedElement::kPaillier:
+            return candidate->mutable_paillier()->mutable_element();
+        case EncryptedElement::kElgamal:
+            return candidate->mutable_elgamal()->mutable_element();
+        default:
+            return candidate->mutable_no_payload()->mutable_element();
+    }
+}
+
+/**
+ * adds a candidate for every new element x and every node y on its path in
+ * their tree: its template with y - x (rerandomized) as the element
+ *
+ * the elements are split across the workers; each one writes the candidates
+ * of its elements into their own slice of the pre-sized candidate list, so
+ * the order is the same as when computed one by one
+ */
+StatusOr<PartyZeroMessage::MessageI> AddCandidates(
+    OfflineMessageI offline,
+    CryptoTree<Ciphertext>* other_tree,
+    ElGamalEncrypter* encrypter
+) {
+    PartyZeroMessage::MessageI msg = std::move(offline.msg);
+    size_t n = offline.elements.size();
+
+    std::vector<std::vector<Ciphertext>> paths(n);
+    RETURN_IF_ERROR(ParallelFor(
+        n, MIN_ELEMENT_CHUNK,
+        [&](size_t begin, size_t end) -> Status {
+            for (size_t i = begin; i < end; i++) {
+                paths[i] = other_tree->getPath(offline.elements[i]);
+            }
+            return OkStatus();
+        }
+    ));
+
+    // candidates of element i start at offsets[i]
+    std::vector<size_t> offsets(n + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+        offsets[i + 1] = offsets[i] + paths[i].size();
+    }
+
+    auto candidates = msg.mutable_candidates()->mutable_elements();
+    candidates->Reserve(offsets[n]);
+    for (size_t k = 0; k < offsets[n]; k++) { candidates->Add(); }
+
+    RETURN_IF_ERROR(ParallelFor(
+        n, MIN_ELEMENT_CHUNK,
+        [&](size_t begin, size_t end) -> Status {
+            for (size_t i = begin; i < end; i++) {
+                for (size_t j = 0; j < paths[i].size(); j++) {
+                    // homomorphically subtract x and rerandomize
+                    ASSIGN_OR_RETURN(
+                        Ciphertext y_minus_x, elgamal::Mul(paths[i][j], offline.minus_x[i])
+                    );
+                    ASSIGN_OR_RETURN(Ciphertext randomized, encrypter->ReRandomize(y_minus_x));
+
+                    EncryptedElement* candidate = candidates->Mutable(offsets[i] + j);
+                    *candidate = offline.templates[i];
+                    ASSIGN_OR_RETURN(
+                        *MutableCandidateElement(candidate),
+                        elgamal_proto_util::SerializeCiphertext(randomized)
+                    );
+                }
+                paths[i].clear();
+            }
+            return OkStatus();
+        }
+    ));
+    return msg;
+}
+
+/**
+ * fills in -x and the candidate template of every new element, in parallel
+ *
+ * encrypt(i, candidate) returns the encryption of the i-th element and fills
+ * in everything else its template needs (e.g. the encrypted payload)
+ */
+Status PrepareCandidates(
+    size_t n,
+    OfflineMessageI* offline,
+    const std::function<StatusOr<Ciphertext>(size_t, EncryptedElement*)>& encrypt
+) {
+    std::vector<std::optional<Ciphertext>> minus_x(n);
+    offline->templates.resize(n);
+
+    RETURN_IF_ERROR(ParallelFor(
+        n, MIN_ELEMENT_CHUNK,
+        [&](size_t begin, size_t end) -> Status {
+            for (size_t i = begin; i < end; i++) {
+                ASSIGN_OR_RETURN(Ciphertext x, encrypt(i, &offline->templates[i]));
+                ASSIGN_OR_RETURN(Ciphertext inverse, elgamal::Invert(x));
+                minus_x[i].emplace(std::move(inverse));
+            }
+            return OkStatus();
+        }
+    ));
+
+    offline->minus_x.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        offline->minus_x.push_back(std::move(*minus_x[i]));
+    }
+    return OkStatus();
+}
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 // WITHOUT PAYLOAD CLASS METHODS
 ////////////////////////////////////////////////////////////////////////////////
@@ -26,11 +151,18 @@ void PartyZeroNoPayload::LoadData(const std::vector<Dataset>& datasets) {
 }
 
 Status PartyZeroNoPayload::Run(Connection* sink) {
+    // our side of the coming days is prepared while they work on this one
+    DayPipeline<OfflineMessageI> pipeline(
+        this->current_day, this->total_days, this->pipeline_days,
+        [this](int day) { return PrepareMessageI(datasets[day]); }
+    );
+
     Timer timer("[PartyZero] Daily Comp");
     while (!ProtocolFinished()) {
         Timer day("[PartyZero] Day " + std::to_string(this->current_day) + " Comp");
         timer.lap();
-        RETURN_IF_ERROR(SendMessageI(sink));
+        ASSIGN_OR_RETURN(OfflineMessageI offline, pipeline.Next());
+        RETURN_IF_ERROR(SendMessageI(std::move(offline), sink));
         ServerMessage message_ii = sink->GetResponse();
         RETURN_IF_ERROR(Handle(message_ii, sink));
         timer.stop();
@@ -40,10 +172,13 @@ Status PartyZeroNoPayload::Run(Connection* sink) {
     return OkStatus();
 }
 
-Status PartyZeroNoPayload::SendMessageI(MessageSink<ClientMessage>* sink) {
+Status PartyZeroNoPayload::SendMessageI(
+    OfflineMessageI offline,
+    MessageSink<ClientMessage>* sink
+) {
     ClientMessage msg;
 
-    ASSIGN_OR_RETURN(auto message_i, GenerateMessageI(datasets[current_day]));
+    ASSIGN_OR_RETURN(auto message_i, CompleteMessageI(std::move(offline)));
 
     *(msg.mutable_party_zero_msg()->mutable_message_i()) = message_i;
     return sink->Send(msg);
@@ -86,10 +221,13 @@ void PartyZeroWithPayload::LoadData(const std::vector<Dataset>& datasets) {
     }
 }
 
-Status PartyZeroWithPayload::SendMessageI(MessageSink<ClientMessage>* sink) {
+Status PartyZeroWithPayload::SendMessageI(
+    OfflineMessageI offline,
+    MessageSink<ClientMessage>* sink
+) {
     ClientMessage msg;
 
-    ASSIGN_OR_RETURN(auto message_i, GenerateMessageI(datasets[current_day]));
+    ASSIGN_OR_RETURN(auto message_i, CompleteMessageI(std::move(offline)));
 
     *(msg.mutable_party_zero_msg()->mutable_message_i()) = message_i;
     return sink->Send(msg);
@@ -120,157 +258,146 @@ Status PartyZeroWithPayload::Handle(const ServerMessage& msg, MessageSink<Client
 // GENERATE MESSAGE I
 ////////////////////////////////////////////////////////////////////////////////
 
-StatusOr<PartyZeroMessage::MessageI> PartyZeroPSI::GenerateMessageI(
+StatusOr<PartyZeroMessage::MessageI> PartyZeroNoPayload::GenerateMessageI(
     std::vector<Element> elements
 ) {
-    PartyZeroMessage::MessageI msg;
-
-    // update our tree
-    RETURN_IF_ERROR(my_tree.Update(
-        this->ctx_, this->encrypter.get(), elements, msg.mutable_updates()
-    ));
+    ASSIGN_OR_RETURN(OfflineMessageI offline, PrepareMessageI(std::move(elements)));
+    return CompleteMessageI(std::move(offline));
+}
 
-    for (size_t i = 0; i < elements.size(); ++i) {
-        // record g^x so we can check if it is in the intersection later
-        ASSIGN_OR_RETURN(ECPoint point, this->encrypter->getPublicKey()->g.Mul(elements[i]));
-        ASSIGN_OR_RETURN(auto key, point.ToBytesUnCompressed());
-        group_mapping[key] = elements[i].ToDecimalString();
+StatusOr<PartyZeroMessage::MessageI> PartyZeroNoPayload::CompleteMessageI(
+    OfflineMessageI offline
+) {
+    return AddCandidates(std::move(offline), &this->other_tree, this->encrypter.get());
+}
 
-        std::vector<Ciphertext> path = this->other_tree.getPath(elements[i]);
+StatusOr<PartyZeroMessage::MessageI> PartyZeroWithPayload::GenerateMessageI(
+    std::vector<ElementAndPayload> elements
+) {
+    ASSIGN_OR_RETURN(OfflineMessageI offline, PrepareMessageI(std::move(elements)));
+    return CompleteMessageI(std::move(offline));
+}
 
-        ASSIGN_OR_RETURN(Ciphertext x, encrypter->Encrypt(point));
-        ASSIGN_OR_RETURN(Ciphertext minus_x, elgamal::Invert(x));
+StatusOr<PartyZeroMessage::MessageI> PartyZeroWithPayload::CompleteMessageI(
+    OfflineMessageI offline
+) {
+    return AddCandidates(std::move(offline), &this->other_tree, this->encrypter.get());
+}
 
-        for (size_t j = 0; j < path.size(); ++j) {
-            Ciphertext y = std::move(path[j]);
+StatusOr<OfflineMessageI> PartyZeroPSI::PrepareMessageI(std::vector<Element> elements) {
+    OfflineMessageI offline;
 
-            // homomorphically subtract x and rerandomize
-            ASSIGN_OR_RETURN(Ciphertext y_minus_x, elgamal::Mul(y, minus_x));
-            ASSIGN_OR_RETURN(Ciphertext randomized, encrypter->ReRandomize(y_minus_x));
+    // update our tree
+    RETURN_IF_ERROR(my_tree.Update(
+        ContextPool::Get(), this->encrypter.get(), elements, offline.msg.mutable_updates()
+    ));
 
-            // add (y - x) and x to the message
-            auto candidate = msg.mutable_candidates()->add_elements();
-            ASSIGN_OR_RETURN(
-                *candidate->mutable_elgamal()->mutable_element(),
-                elgamal_proto_util::SerializeCiphertext(randomized)
-            );
+    offline.index_entries.resize(elements.size());
+    RETURN_IF_ERROR(PrepareCandidates(
+        elements.size(), &offline,
+        [&](size_t i, EncryptedElement* candidate) -> StatusOr<Ciphertext> {
+            // record g^x so we can check if it is in the intersection later
+            ASSIGN_OR_RETURN(ECPoint point, this->encrypter->getPublicKey()->g.Mul(elements[i]));
+            ASSIGN_OR_RETURN(uint64_t fingerprint, IntersectionIndex::Fingerprint(point));
+            ASSIGN_OR_RETURN(uint64_t id, elements[i].ToIntValue());
+            offline.index_entries[i] = std::make_pair(fingerprint, id);
+
+            // x is sent along with every (y - x)
+            ASSIGN_OR_RETURN(Ciphertext x, encrypter->Encrypt(point));
             ASSIGN_OR_RETURN(
                 *candidate->mutable_elgamal()->mutable_payload(),
                 elgamal_proto_util::SerializeCiphertext(x)
             );
+            return x;
         }
-    }
+    ));
+    offline.elements = std::move(elements);
 
-    return msg;
+    return offline;
 }
 
-StatusOr<PartyZeroMessage::MessageI> PartyZeroCardinality::GenerateMessageI(
-    std::vector<Element> elements
-) {
-    PartyZeroMessage::MessageI msg;
+StatusOr<PartyZeroMessage::MessageI> PartyZeroPSI::CompleteMessageI(OfflineMessageI offline) {
+    this->my_index.Reserve(this->my_index.size() + offline.index_entries.size());
+    for (const auto& [fingerprint, id] : offline.index_entries) {
+        this->my_index.Insert(fingerprint, id);
+    }
+    return PartyZeroNoPayload::CompleteMessageI(std::move(offline));
+}
+
+StatusOr<OfflineMessageI> PartyZeroCardinality::PrepareMessageI(std::vector<Element> elements) {
+    OfflineMessageI offline;
 
     // update our tree
     RETURN_IF_ERROR(my_tree.Update(
-        this->ctx_, this->encrypter.get(), elements, msg.mutable_updates()
+        ContextPool::Get(), this->encrypter.get(), elements, offline.msg.mutable_updates()
     ));
 
-    for (size_t i = 0; i < elements.size(); ++i) {
-        std::vector<Ciphertext> path = this->other_tree.getPath(elements[i]);
-        ASSIGN_OR_RETURN(Ciphertext x, encrypter->Encrypt(elements[i]));
-        ASSIGN_OR_RETURN(Ciphertext minus_x, elgamal::Invert(x));
-
-        for (size_t j = 0; j < path.size(); ++j) {
-            Ciphertext y = std::move(path[j]);
-
-            // homomorphically subtract x and rerandomize
-            ASSIGN_OR_RETURN(Ciphertext y_minus_x, elgamal::Mul(y, minus_x));
-            ASSIGN_OR_RETURN(Ciphertext randomized, encrypter->ReRandomize(y_minus_x));
-
-            // add this to the message
-            auto candidate = msg.mutable_candidates()->add_elements();
-            ASSIGN_OR_RETURN(
-                *candidate->mutable_no_payload()->mutable_element(),
-                elgamal_proto_util::SerializeCiphertext(randomized)
-            );
+    RETURN_IF_ERROR(PrepareCandidates(
+        elements.size(), &offline,
+        [&](size_t i, EncryptedElement* candidate) -> StatusOr<Ciphertext> {
+            candidate->mutable_no_payload();
+            return encrypter->Encrypt(elements[i]);
         }
-    }
+    ));
+    offline.elements = std::move(elements);
 
-    return msg;
+    return offline;
 }
 
-StatusOr<PartyZeroMessage::MessageI> PartyZeroSum::GenerateMessageI(
+StatusOr<OfflineMessageI> PartyZeroSum::PrepareMessageI(
     std::vector<ElementAndPayload> elements
 ) {
-    PartyZeroMessage::MessageI msg;
+    OfflineMessageI offline;
 
     // update our tree
     RETURN_IF_ERROR(my_tree.Update(
-        this->ctx_, this->encrypter.get(), elements, msg.mutable_updates()
+        ContextPool::Get(), this->encrypter.get(), elements, offline.msg.mutable_updates()
     ));
 
-    for (size_t i = 0; i < elements.size(); ++i) {
-        std::vector<Ciphertext> path = this->other_tree.getPath(elements[i].first);
-        ASSIGN_OR_RETURN(Ciphertext x, encrypter->Encrypt(elements[i].first));
-        ASSIGN_OR_RETURN(Ciphertext minus_x, elgamal::Invert(x));
-        ASSIGN_OR_RETURN(Ciphertext payload, encrypter->Encrypt(elements[i].second));
-
-        for (size_t j = 0; j < path.size(); ++j) {
-            Ciphertext y = std::move(path[j]);
-
-            // homomorphically subtract x and rerandomize
-            ASSIGN_OR_RETURN(Ciphertext y_minus_x, elgamal::Mul(y, minus_x));
-            ASSIGN_OR_RETURN(Ciphertext randomized, encrypter->ReRandomize(y_minus_x));
-
-            // add this to the message
-            auto candidate = msg.mutable_candidates()->add_elements();
-            ASSIGN_OR_RETURN(
-                *candidate->mutable_elgamal()->mutable_element(),
-                elgamal_proto_util::SerializeCiphertext(randomized)
-            );
+    RETURN_IF_ERROR(PrepareCandidates(
+        elements.size(), &offline,
+        [&](size_t i, EncryptedElement* candidate) -> StatusOr<Ciphertext> {
+            ASSIGN_OR_RETURN(Ciphertext payload, encrypter->Encrypt(elements[i].second));
             ASSIGN_OR_RETURN(
                 *candidate->mutable_elgamal()->mutable_payload(),
                 elgamal_proto_util::SerializeCiphertext(payload)
             );
+            return encrypter->Encrypt(elements[i].first);
         }
+    ));
+
+    for (auto& element : elements) {
+        offline.elements.push_back(std::move(element.first));
     }
 
-    return msg;
+    return offline;
 }
 
-StatusOr<PartyZeroMessage::MessageI> PartyZeroSecretShare::GenerateMessageI(
+StatusOr<OfflineMessageI> PartyZeroSecretShare::PrepareMessageI(
     std::vector<ElementAndPayload> elements
 ) {
-    PartyZeroMessage::MessageI msg;
+    OfflineMessageI offline;
 
     // update our tree
     RETURN_IF_ERROR(my_tree.Update(
-        this->ctx_, this->encrypter.get(), this->paillier.get(), elements, msg.mutable_updates()
+        ContextPool::Get(), this->encrypter.get(), this->paillier.get(), elements,
+        offline.msg.mutable_updates()
     ));
 
-    for (size_t i = 0; i < elements.size(); ++i) {
-        std::vector<Ciphertext> path = this->other_tree.getPath(elements[i].first);
-        ASSIGN_OR_RETURN(Ciphertext x, encrypter->Encrypt(elements[i].first));
-        ASSIGN_OR_RETURN(Ciphertext minus_x, elgamal::Invert(x));
-        ASSIGN_OR_RETURN(BigNum payload, paillier->Encrypt(elements[i].second));
-
-        for (size_t j = 0; j < path.size(); ++j) {
-            Ciphertext y = std::move(path[j]);
-
-            // homomorphically subtract x and rerandomize
-            ASSIGN_OR_RETURN(Ciphertext y_minus_x, elgamal::Mul(y, minus_x));
-            ASSIGN_OR_RETURN(Ciphertext randomized, encrypter->ReRandomize(y_minus_x));
-
-            // add this to the message
-            auto candidate = msg.mutable_candidates()->add_elements();
-            ASSIGN_OR_RETURN(
-                *candidate->mutable_paillier()->mutable_element(),
-                elgamal_proto_util::SerializeCiphertext(randomized)
-            );
+    RETURN_IF_ERROR(PrepareCandidates(
+        elements.size(), &offline,
+        [&](size_t i, EncryptedElement* candidate) -> StatusOr<Ciphertext> {
+            ASSIGN_OR_RETURN(BigNum payload, paillier->Encrypt(elements[i].second));
             *candidate->mutable_paillier()->mutable_payload() = payload.ToBytes();
+            return encrypter->Encrypt(elements[i].first);
         }
+    ));
+
+    for (auto& element : elements) {
+        offline.elements.push_back(std::move(element.first));
     }
 
-    return msg;
+    return offline;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -291,11 +418,17 @@ Status PartyZeroPSI::ProcessMessageII(const PartyOneMessage::MessageII& res) {
     );
 
     for (const std::pair<Ciphertext, Ciphertext>& candidate : candidates) {
-        ASSIGN_OR_RETURN(ECPoint plaintext, decrypter->Decrypt(candidate.first));
-        if (plaintext.IsPointAtInfinity()) {
+        ASSIGN_OR_RETURN(bool is_zero, decrypter->IsEncryptionOfZero(candidate.first));
+        if (is_zero) {
             ASSIGN_OR_RETURN(ECPoint point, decrypter->Decrypt(candidate.second));
-            ASSIGN_OR_RETURN(auto key, point.ToBytesUnCompressed());
-            intersection.push_back(group_mapping[key]);
+            ASSIGN_OR_RETURN(uint64_t fingerprint, IntersectionIndex::Fingerprint(point));
+            std::optional<uint64_t> element = this->my_index.Find(fingerprint);
+            if (!element.has_value()) {
+                return InternalError(
+                    "[PartyZeroPSI] intersection element is missing from the index"
+                );
+            }
+            intersection.push_back(std::to_string(*element));
         }
     }
 
@@ -308,17 +441,35 @@ Status PartyZeroCardinality::ProcessMessageII(const PartyOneMessage::MessageII&
 
     RETURN_IF_ERROR(other_tree.Update(this->ctx_, this->group, &res.updates()));
 
-    ASSIGN_OR_RETURN(
-        std::vector<Ciphertext> candidates,
-        DeserializeCiphertexts<Ciphertext>(res.candidates().elements(), this->ctx_, this->group)
-    );
-
-    for (const Ciphertext& candidate : candidates) {
-        ASSIGN_OR_RETURN(ECPoint plaintext, decrypter->Decrypt(candidate));
-        if (plaintext.IsPointAtInfinity()) {
-            this->cardinality++;
+    // each worker decodes and tests its candidates one at a time, so they are
+    // never all deserialized at once
+    const auto& candidates = res.candidates().elements();
+    std::mutex mu;
+    RETURN_IF_ERROR(ParallelFor(
+        candidates.size(), MIN_RECEIVED_CHUNK,
+        [&](size_t begin, size_t end) -> Status {
+            int64_t count = 0;
+            for (size_t i = begin; i < end; i++) {
+                if (!candidates[i].has_no_payload()) {
+                    return InvalidArgumentError(
+                        "[PartyZeroCardinality] received a candidate with a payload"
+                    );
+                }
+                ASSIGN_OR_RETURN(
+                    Ciphertext candidate,
+                    elgamal_proto_util::DeserializeCiphertext(
+                        this->group, candidates[i].no_payload().element()
+                    )
+                );
+                ASSIGN_OR_RETURN(bool is_zero, decrypter->IsEncryptionOfZero(candidate));
+                if (is_zero) { count++; }
+            }
+
+            std::lock_guard<std::mutex> lock(mu);
+            this->cardinality += count;
+            return OkStatus();
         }
-    }
+    ));
 
     // the day is over after the second message
     FinishDay();
@@ -332,23 +483,56 @@ Status PartyZeroSum::SendMessageIII(
     // update their tree
     RETURN_IF_ERROR(other_tree.Update(this->ctx_, this->group, &res.updates()));
 
-    // deserialize candidates
-    ASSIGN_OR_RETURN(
-        std::vector<CiphertextAndElGamal> candidates,
-        DeserializeCiphertexts<CiphertextAndElGamal>(
-            res.candidates().elements(), this->ctx_, this->group
-        )
-    );
-
-    // compute ciphertext of intersection sum
+    // compute ciphertext of intersection sum: each worker decodes, tests and
+    // adds up its candidates one at a time (decoding a payload only if it is
+    // needed), and the partial sums are combined at the end. The payloads
+    // come off the wire in affine form, so every addition into a partial sum
+    // is already a mixed addition.
+    const auto& candidates = res.candidates().elements();
     ASSIGN_OR_RETURN(Ciphertext sum, encrypter->Encrypt(this->ctx_->Zero()));
-    for (size_t i = 0; i < candidates.size(); i++) {
-        ASSIGN_OR_RETURN(ECPoint plaintext, decrypter->Decrypt(candidates[i].first));
-        if (plaintext.IsPointAtInfinity()) {
-            this->cardinality++;
-            ASSIGN_OR_RETURN(sum, elgamal::Mul(sum, candidates[i].second));
+    std::mutex mu;
+    RETURN_IF_ERROR(ParallelFor(
+        candidates.size(), MIN_RECEIVED_CHUNK,
+        [&](size_t begin, size_t end) -> Status {
+            std::optional<Ciphertext> partial;
+            uint64_t count = 0;
+            for (size_t i = begin; i < end; i++) {
+                if (!candidates[i].has_elgamal()) {
+                    return InvalidArgumentError(
+                        "[PartyZeroSum] received a candidate without El Gamal payload"
+                    );
+                }
+                ASSIGN_OR_RETURN(
+                    Ciphertext candidate,
+                    elgamal_proto_util::DeserializeCiphertext(
+                        this->group, candidates[i].elgamal().element()
+                    )
+                );
+                ASSIGN_OR_RETURN(bool is_zero, decrypter->IsEncryptionOfZero(candidate));
+                if (!is_zero) { continue; }
+
+                count++;
+                ASSIGN_OR_RETURN(
+                    Ciphertext payload,
+                    elgamal_proto_util::DeserializeCiphertext(
+                        this->group, candidates[i].elgamal().payload()
+                    )
+                );
+                if (partial.has_value()) {
+                    ASSIGN_OR_RETURN(*partial, elgamal::Mul(*partial, payload));
+                } else {
+                    partial.emplace(std::move(payload));
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mu);
+            this->cardinality += count;
+            if (partial.has_value()) {
+                ASSIGN_OR_RETURN(sum, elgamal::Mul(sum, *partial));
+            }
+            return OkStatus();
         }
-    }
+    ));
 
     // send ciphertext for decryption
     PartyZeroMessage::MessageIII_SUM req;
@@ -377,23 +561,45 @@ Status PartyZeroSecretShare::SendMessageIII(
         )
     );
 
-    // generate our shares and evaluate the ciphertexts for their shares
-    PartyZeroMessage::MessageIII_SS req;
-    for (size_t i = 0; i < candidates.size(); i++) {
-        ASSIGN_OR_RETURN(ECPoint plaintext, decrypter->Decrypt(candidates[i].first));
-        if (plaintext.IsPointAtInfinity()) {
-            BigNum share = this->ctx_->GenerateRandLessThan(this->paillier->n);
-
-            // save -share as our share
-            shares.push_back(this->paillier->n - share);
-
-            // element + share is their share
-            ASSIGN_OR_RETURN(BigNum encrypted, this->paillier->Encrypt(share));
-            encrypted = paillier->Add(candidates[i].second, encrypted);
-            ASSIGN_OR_RETURN(BigNum partial, this->paillier->PartialDecrypt(encrypted));
-            *req.add_payloads()->mutable_ciphertext() = encrypted.ToBytes();
-            *req.add_payloads()->mutable_ciphertext() = partial.ToBytes();
+    // find the matching candidates across the workers; each one only writes
+    // the flags of its own candidates (char rather than a packed bool, so
+    // that neighbouring flags can be written at the same time)
+    std::vector<char> is_match(candidates.size());
+    RETURN_IF_ERROR(ParallelFor(
+        candidates.size(), MIN_RECEIVED_CHUNK,
+        [&](size_t begin, size_t end) -> Status {
+            for (size_t i = begin; i < end; i++) {
+                ASSIGN_OR_RETURN(bool is_zero, decrypter->IsEncryptionOfZero(candidates[i].first));
+                is_match[i] = is_zero;
+            }
+            return OkStatus();
         }
+    ));
+    std::vector<BigNum> matched;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (is_match[i]) { matched.push_back(std::move(candidates[i].second)); }
+    }
+
+    // generate our shares, saving -share as ours
+    std::vector<BigNum> masks = ContextPool::GetDrbg()->GenerateRandLessThan(
+        this->paillier->n, matched.size()
+    );
+    for (const BigNum& mask : masks) {
+        shares.push_back(this->paillier->n - mask);
+    }
+
+    // element + share is their share; all matches are encrypted and then
+    // partially decrypted as one batch each
+    ASSIGN_OR_RETURN(std::vector<BigNum> encrypted, this->paillier->EncryptBatch(masks));
+    for (size_t i = 0; i < matched.size(); i++) {
+        encrypted[i] = this->paillier->Add(matched[i], encrypted[i]);
+    }
+    ASSIGN_OR_RETURN(std::vector<BigNum> partials, this->paillier->PartialDecryptBatch(encrypted));
+
+    PartyZeroMessage::MessageIII_SS req;
+    for (size_t i = 0; i < matched.size(); i++) {
+        *req.add_payloads()->mutable_ciphertext() = encrypted[i].ToBytes();
+        *req.add_payloads()->mutable_ciphertext() = partials[i].ToBytes();
     }
 
     // the day is over for us since there are no more incoming messages
@@ -421,11 +627,18 @@ ElementAndPayload PartyZeroSecretShare::GetPayload(BigNum element, BigNum value)
 ////////////////////////////////////////////////////////////////////////////////
 
 Status PartyZeroSum::Run(Connection* sink) {
+    // our side of the coming days is prepared while they work on this one
+    DayPipeline<OfflineMessageI> pipeline(
+        this->current_day, this->total_days, this->pipeline_days,
+        [this](int day) { return PrepareMessageI(datasets[day]); }
+    );
+
     Timer timer("[PartyZero] Daily Comp");
     while (!ProtocolFinished()) {
         Timer day("[PartyZero] Day " + std::to_string(this->current_day) + " Comp");
         timer.lap();
-        RETURN_IF_ERROR(SendMessageI(sink));
+        ASSIGN_OR_RETURN(OfflineMessageI offline, pipeline.Next());
+        RETURN_IF_ERROR(SendMessageI(std::move(offline), sink));
 
         ServerMessage message_ii = sink->GetResponse();
         RETURN_IF_ERROR(Handle(message_ii, sink));
@@ -440,11 +653,18 @@ Status PartyZeroSum::Run(Connection* sink) {
 }
 
 Status PartyZeroSecretShare::Run(Connection* sink) {
+    // our side of the coming days is prepared while they work on this one
+    DayPipeline<OfflineMessageI> pipeline(
+        this->current_day, this->total_days, this->pipeline_days,
+        [this](int day) { return PrepareMessageI(datasets[day]); }
+    );
+
     Timer timer("[PartyZero] Daily Comp");
     while (!ProtocolFinished()) {
         Timer day("[PartyZero] Day " + std::to_string(this->current_day) + " Comp");
         timer.lap();
-        RETURN_IF_ERROR(SendMessageI(sink));
+        ASSIGN_OR_RETURN(OfflineMessageI offline, pipeline.Next());
+        RETURN_IF_ERROR(SendMessageI(std::move(offline), sink));
 
         ServerMessage message_ii = sink->GetResponse();
 
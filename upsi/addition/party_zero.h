@@ -6,15 +6,42 @@
 #include "upsi/roles.h"
 #include "upsi/network/upsi.pb.h"
 #include "upsi/util/data_util.h"
+#include "upsi/util/day_pipeline.h"
 #include "upsi/util/status.inc"
 #include "upsi/utils.h"
 
 namespace upsi {
 namespace addonly {
 
+/**
+ * the part of a day's first message that only depends on our own data: the
+ * update of our tree and the encryptions of the new elements
+ *
+ * the candidates against their tree are added by CompleteMessageI, once
+ * their update from the previous day has been applied
+ */
+struct OfflineMessageI {
+    // first message with only the tree updates filled in
+    PartyZeroMessage::MessageI msg;
+
+    // the new elements (without payloads), to look up in their tree
+    std::vector<Element> elements;
+
+    // encryption of -x for each new element x
+    std::vector<Ciphertext> minus_x;
+
+    // for each new element, the candidate sent for every node on its path,
+    // with everything but the element difference filled in
+    std::vector<EncryptedElement> templates;
+
+    // PSI only: (fingerprint of g^x, x) for each new element
+    std::vector<std::pair<uint64_t, uint64_t>> index_entries;
+};
+
 class PartyZero : public Client {
     public:
-        using Client::Client;
+        PartyZero(PSIParams* params) :
+            Client(params), pipeline_days(std::max(params->pipeline_days, 0)) { }
 
         /**
          * set the datasets variable based on the functionality
@@ -22,6 +49,10 @@ class PartyZero : public Client {
          * this can't happen in the constructor for weird inheritance reasons
          */
         virtual void LoadData(const std::vector<Dataset>& datasets) = 0;
+
+    protected:
+        // days of first messages prepared in the background (0 disables)
+        int pipeline_days;
 };
 
 class PartyZeroNoPayload : public Party<Element, Ciphertext>, public PartyZero {
@@ -39,11 +70,20 @@ class PartyZeroNoPayload : public Party<Element, Ciphertext>, public PartyZero {
         /**
          * send tree updates & intersection candidates
          */
-        Status SendMessageI(MessageSink<ClientMessage>* sink);
+        Status SendMessageI(OfflineMessageI offline, MessageSink<ClientMessage>* sink);
 
-        virtual StatusOr<PartyZeroMessage::MessageI> GenerateMessageI(
-            std::vector<Element> elements
-        ) = 0;
+        /**
+         * update our tree & encrypt the new elements; this runs ahead of the
+         * protocol (see DayPipeline) so it may not touch their tree
+         */
+        virtual StatusOr<OfflineMessageI> PrepareMessageI(std::vector<Element> elements) = 0;
+
+        /**
+         * add the intersection candidates against their current tree
+         */
+        virtual StatusOr<PartyZeroMessage::MessageI> CompleteMessageI(OfflineMessageI offline);
+
+        StatusOr<PartyZeroMessage::MessageI> GenerateMessageI(std::vector<Element> elements);
 
         /**
          * update their tree & compute cardinality
@@ -68,9 +108,12 @@ class PartyZeroPSI : public PartyZeroNoPayload {
 
         virtual ~PartyZeroPSI() = default;
 
-        StatusOr<PartyZeroMessage::MessageI> GenerateMessageI(
-            std::vector<Element> elements
-        ) override;
+        StatusOr<OfflineMessageI> PrepareMessageI(std::vector<Element> elements) override;
+
+        /**
+         * record the new elements for the intersection lookup
+         */
+        StatusOr<PartyZeroMessage::MessageI> CompleteMessageI(OfflineMessageI offline) override;
 
         /**
          * update their tree & compute cardinality
@@ -83,9 +126,6 @@ class PartyZeroPSI : public PartyZeroNoPayload {
         void PrintResult() override;
 
     private:
-        // maps g^x to x
-        std::map<std::string, std::string> group_mapping;
-
         // elements in the intersection
         std::vector<std::string> intersection;
 };
@@ -99,9 +139,7 @@ class PartyZeroCardinality : public PartyZeroNoPayload {
 
         virtual ~PartyZeroCardinality() = default;
 
-        StatusOr<PartyZeroMessage::MessageI> GenerateMessageI(
-            std::vector<Element> elements
-        ) override;
+        StatusOr<OfflineMessageI> PrepareMessageI(std::vector<Element> elements) override;
 
         /**
          * update their tree & compute cardinality
@@ -140,12 +178,25 @@ class PartyZeroWithPayload : public Party<ElementAndPayload, Ciphertext>,
         /**
          * send tree updates & intersection candidates
          */
-        Status SendMessageI(MessageSink<ClientMessage>* sink);
+        Status SendMessageI(OfflineMessageI offline, MessageSink<ClientMessage>* sink);
 
-        virtual StatusOr<PartyZeroMessage::MessageI> GenerateMessageI(
+        /**
+         * update our tree & encrypt the new elements and payloads; this runs
+         * ahead of the protocol (see DayPipeline) so it may not touch their tree
+         */
+        virtual StatusOr<OfflineMessageI> PrepareMessageI(
             std::vector<ElementAndPayload> elements
         ) = 0;
 
+        /**
+         * add the intersection candidates against their current tree
+         */
+        StatusOr<PartyZeroMessage::MessageI> CompleteMessageI(OfflineMessageI offline);
+
+        StatusOr<PartyZeroMessage::MessageI> GenerateMessageI(
+            std::vector<ElementAndPayload> elements
+        );
+
         /**
          * update their tree & (optionally) send follow up message
          */
@@ -187,7 +238,7 @@ class PartyZeroSum : public PartyZeroWithPayload {
 
         Status Run(Connection* sink) override;
 
-        StatusOr<PartyZeroMessage::MessageI> GenerateMessageI(
+        StatusOr<OfflineMessageI> PrepareMessageI(
             std::vector<ElementAndPayload> elements
         ) override;
 
@@ -211,6 +262,9 @@ class PartyZeroSecretShare : public PartyZeroWithPayload {
     public:
         // use the default constructor
         PartyZeroSecretShare(PSIParams* params) : PartyZeroWithPayload(params) {
+            if (params->paillier_pool > 0) {
+                this->paillier->StartBackgroundRandomness(params->paillier_pool);
+            }
             if (params->start_size > 0) {
                 auto status = CreateMockTrees(params->start_size);
                 if (!status.ok()) {
@@ -263,7 +317,7 @@ class PartyZeroSecretShare : public PartyZeroWithPayload {
 
         Status Run(Connection* sink) override;
 
-        StatusOr<PartyZeroMessage::MessageI> GenerateMessageI(
+        StatusOr<OfflineMessageI> PrepareMessageI(
             std::vector<ElementAndPayload> elements
         ) override;
 
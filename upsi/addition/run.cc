@@ -28,6 +28,7 @@
 #include "upsi/network/upsi.pb.h"
 #include "upsi/util/status.inc"
 #include "upsi/util/data_util.h"
+#include "upsi/util/elgamal_key_util.h"
 #include "upsi/utils.h"
 
 using namespace upsi;
@@ -43,6 +44,10 @@ ABSL_FLAG(int, days, 10, "total days the protocol will run for");
 ABSL_FLAG(bool, trees, false, "use initial trees stored on disk");
 ABSL_FLAG(int, start_size, -1, "size of the initial trees (if creating random)");
 
+ABSL_FLAG(int, pipeline_days, PIPELINE_DAYS, "days party zero prepares ahead (0 disables)");
+ABSL_FLAG(int, batch_days, 1, "days merged into each protocol round, e.g. to catch up (must match on both parties)");
+ABSL_FLAG(int, paillier_pool, 0, "paillier randomizers precomputed in the background (0 disables)");
+
 Status RunPartyZero() {
     Context context;
 
@@ -53,6 +58,11 @@ Status RunPartyZero() {
         absl::GetFlag(FLAGS_out_dir) + "p0/paillier.key",
         absl::GetFlag(FLAGS_days)
     );
+    params.paillier_pool = absl::GetFlag(FLAGS_paillier_pool);
+    params.pipeline_days = absl::GetFlag(FLAGS_pipeline_days);
+
+    // run over whichever curve the keys were generated on
+    ASSIGN_OR_RETURN(params.curve_id, elgamal_key_util::ReadCurveId(params.epk_fn));
 
     if (absl::GetFlag(FLAGS_trees)) {
         params.my_tree_fn = absl::GetFlag(FLAGS_data_dir) + "p0/plaintext.tree";
@@ -66,6 +76,15 @@ Status RunPartyZero() {
         &context, absl::GetFlag(FLAGS_data_dir) + "p0/", absl::GetFlag(FLAGS_days)
     );
 
+    // catch up on several days per round: their elements are inserted and
+    // checked as one batch, so only the aggregate over the batch is output
+    if (absl::GetFlag(FLAGS_batch_days) > 1) {
+        dataset = MergeDailyDatasets(dataset, absl::GetFlag(FLAGS_batch_days));
+        params.total_days = dataset.size();
+        std::cout << "[PartyZero] running " << params.total_days << " rounds of up to ";
+        std::cout << absl::GetFlag(FLAGS_batch_days) << " days" << std::endl;
+    }
+
     std::unique_ptr<PartyZero> party_zero;
     switch (absl::GetFlag(FLAGS_func)) {
         case Functionality::PSI:
@@ -115,6 +134,10 @@ Status RunPartyOne() {
         absl::GetFlag(FLAGS_out_dir) + "p1/paillier.key",
         absl::GetFlag(FLAGS_days)
     );
+    params.paillier_pool = absl::GetFlag(FLAGS_paillier_pool);
+
+    // run over whichever curve the keys were generated on
+    ASSIGN_OR_RETURN(params.curve_id, elgamal_key_util::ReadCurveId(params.epk_fn));
 
     if (absl::GetFlag(FLAGS_trees)) {
         params.my_tree_fn = absl::GetFlag(FLAGS_data_dir) + "p1/plaintext.tree";
@@ -128,6 +151,15 @@ Status RunPartyOne() {
         &context, absl::GetFlag(FLAGS_data_dir) + "p1/", absl::GetFlag(FLAGS_days)
     );
 
+    // catch up on several days per round: their elements are inserted and
+    // checked as one batch, so only the aggregate over the batch is output
+    if (absl::GetFlag(FLAGS_batch_days) > 1) {
+        dataset = MergeDailyDatasets(dataset, absl::GetFlag(FLAGS_batch_days));
+        params.total_days = dataset.size();
+        std::cout << "[PartyOne] running " << params.total_days << " rounds of up to ";
+        std::cout << absl::GetFlag(FLAGS_batch_days) << " days" << std::endl;
+    }
+
     std::shared_ptr<PartyOne> party_one;
     switch (absl::GetFlag(FLAGS_func)) {
         case Functionality::PSI:
@@ -25,6 +25,7 @@ ABSL_FLAG(std::string, shared_fn, "shared", "prefix for shared key file");
 
 ABSL_FLAG(int32_t, mod_length, 1536, "bit-length of Paillier modulus");
 ABSL_FLAG(int32_t, stat_param, 100, "statistical parameter for Paillier");
+ABSL_FLAG(std::string, prime_cache, "", "file of reusable safe primes for the Paillier keys (testing only)");
 
 ABSL_FLAG(uint32_t, days, 10, "number of days the protocol is running for");
 
@@ -39,6 +40,8 @@ ABSL_FLAG(Functionality, func, Functionality::CA, "which functionality to prepar
 
 ABSL_FLAG(bool, expected, true, "compute expected cardinality and sum");
 
+ABSL_FLAG(std::string, curve, "P-256", "elliptic curve for the el gamal keys (P-224, P-256, P-384, P-521)");
+
 Status GenerateData(Context* ctx) {
     std::cout << "[Setup] generating mock data" << std::endl;
 
@@ -76,7 +79,11 @@ Status GenerateData(Context* ctx) {
 
     if (start_size > 0) {
         std::cout << "[Setup] writing initial trees" << std::flush;
-        ECGroup group(ECGroup::Create(CURVE_ID, ctx).value());
+        // build the trees over whichever curve the keys were generated on
+        ASSIGN_OR_RETURN(
+            int curve_id, elgamal_key_util::ReadCurveId(p0_key_dir + "shared.pub")
+        );
+        ASSIGN_OR_RETURN(ECGroup group, ECGroup::Create(curve_id, ctx));
         RETURN_IF_ERROR(
             GenerateTrees(
                 ctx, &group, p0_tree.ElementsAndValues(),
@@ -132,12 +139,19 @@ int main(int argc, char** argv) {
     Context ctx;
 
     if (absl::GetFlag(FLAGS_keys)) {
+        auto curve_id = CurveIdFromName(absl::GetFlag(FLAGS_curve));
+        if (!curve_id.ok()) {
+            std::cerr << "[Setup] " << curve_id.status() << std::endl;
+            return 1;
+        }
         auto status = GenerateThresholdKeys(
             &ctx,
             absl::GetFlag(FLAGS_out_dir) + "p0/",
             absl::GetFlag(FLAGS_out_dir) + "p1/",
             absl::GetFlag(FLAGS_mod_length),
-            absl::GetFlag(FLAGS_stat_param)
+            absl::GetFlag(FLAGS_stat_param),
+            curve_id.value(),
+            absl::GetFlag(FLAGS_prime_cache)
         );
         if (!status.ok()) {
             std::cerr << "[Setup] failure generating keys" << std::endl;
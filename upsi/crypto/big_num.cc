@@ -22,6 +22,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "upsi/crypto/context.h"
+#include "upsi/crypto/object_pool.h"
 #include "upsi/crypto/openssl.inc"
 #include "upsi/util/status.inc"
 
@@ -44,53 +45,42 @@ class BnString {
 
 }  // namespace
 
-BigNum::BigNum(const BigNum& other)
-    : bn_(BignumPtr(BN_dup(other.bn_.get()))), bn_ctx_(other.bn_ctx_) {}
+BigNum::BigNum(const BigNum& other) : BigNum::BigNum() {
+  CRYPTO_CHECK(nullptr != BN_copy(bn_.get(), other.bn_.get()));
+}
 
 BigNum& BigNum::operator=(const BigNum& other) {
-  BIGNUM* temp = BN_dup(other.bn_.get());
-  CHECK_NE(temp, nullptr);
-  bn_ = BignumPtr(temp);
-  bn_ctx_ = other.bn_ctx_;
+  if (bn_ == nullptr) {
+    bn_ = BignumPtr(ObjectPool::NewBignum());
+  }
+  CRYPTO_CHECK(nullptr != BN_copy(bn_.get(), other.bn_.get()));
   return *this;
 }
 
-BigNum::BigNum(BigNum&& other)
-    : bn_(std::move(other.bn_)), bn_ctx_(other.bn_ctx_) {}
+BigNum::BigNum(BigNum&& other) : bn_(std::move(other.bn_)) {}
 
 BigNum& BigNum::operator=(BigNum&& other) {
   bn_ = std::move(other.bn_);
-  bn_ctx_ = other.bn_ctx_;
   return *this;
 }
 
-BigNum::BigNum(BN_CTX* bn_ctx, uint64_t number) : BigNum::BigNum(bn_ctx) {
+BigNum::BigNum(uint64_t number) : BigNum::BigNum() {
   CRYPTO_CHECK(BN_set_u64(bn_.get(), number));
 }
 
-BigNum::BigNum(BN_CTX* bn_ctx, absl::string_view bytes)
-    : BigNum::BigNum(bn_ctx) {
+BigNum::BigNum(absl::string_view bytes) : BigNum::BigNum() {
   CRYPTO_CHECK(nullptr !=
                BN_bin2bn(reinterpret_cast<const unsigned char*>(bytes.data()),
                          bytes.size(), bn_.get()));
 }
 
-BigNum::BigNum(BN_CTX* bn_ctx, const unsigned char* bytes, int length)
-    : BigNum::BigNum(bn_ctx) {
+BigNum::BigNum(const unsigned char* bytes, int length) : BigNum::BigNum() {
   CRYPTO_CHECK(nullptr != BN_bin2bn(bytes, length, bn_.get()));
 }
 
-BigNum::BigNum(BN_CTX* bn_ctx) {
-  BIGNUM* temp = BN_new();
-  CHECK_NE(temp, nullptr);
-  bn_ = BignumPtr(temp);
-  bn_ctx_ = bn_ctx;
-}
+BigNum::BigNum() : bn_(ObjectPool::NewBignum()) {}
 
-BigNum::BigNum(BN_CTX* bn_ctx, BignumPtr bn) {
-  bn_ = std::move(bn);
-  bn_ctx_ = bn_ctx;
-}
+BigNum::BigNum(BignumPtr bn) { bn_ = std::move(bn); }
 
 const BIGNUM* BigNum::GetConstBignumPtr() const { return bn_.get(); }
 
@@ -119,12 +109,12 @@ int BigNum::BitLength() const { return BN_num_bits(bn_.get()); }
 
 bool BigNum::IsPrime(double prime_error_probability) const {
   int rounds = static_cast<int>(ceil(-log(prime_error_probability) / log(4)));
-  return (1 == BN_is_prime_ex(bn_.get(), rounds, bn_ctx_, nullptr));
+  return (1 == BN_is_prime_ex(bn_.get(), rounds, ContextPool::GetBnCtx(), nullptr));
 }
 
 bool BigNum::IsSafePrime(double prime_error_probability) const {
   return IsPrime(prime_error_probability) &&
-         ((*this - BigNum(bn_ctx_, 1)) / BigNum(bn_ctx_, 2))
+         ((*this - BigNum(1)) / BigNum(2))
              .IsPrime(prime_error_probability);
 }
 
@@ -154,42 +144,38 @@ BigNum BigNum::Neg() const {
 }
 
 BigNum BigNum::Add(const BigNum& val) const {
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(1 == BN_add(r.bn_.get(), bn_.get(), val.bn_.get()));
   return r;
 }
 
 BigNum BigNum::Mul(const BigNum& val) const {
-  BigNum r(bn_ctx_);
-  CRYPTO_CHECK(1 == BN_mul(r.bn_.get(), bn_.get(), val.bn_.get(), bn_ctx_));
+  BigNum r;
+  CRYPTO_CHECK(1 == BN_mul(r.bn_.get(), bn_.get(), val.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
 BigNum BigNum::Sub(const BigNum& val) const {
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(1 == BN_sub(r.bn_.get(), bn_.get(), val.bn_.get()));
   return r;
 }
 
 BigNum BigNum::Div(const BigNum& val) const {
-  BigNum r(bn_ctx_);
-  BIGNUM* temp = BN_new();
-  CHECK_NE(temp, nullptr);
-  BignumPtr rem(temp);
+  BigNum r;
+  BignumPtr rem(ObjectPool::NewBignum());
   CRYPTO_CHECK(
-      1 == BN_div(r.bn_.get(), rem.get(), bn_.get(), val.bn_.get(), bn_ctx_));
+      1 == BN_div(r.bn_.get(), rem.get(), bn_.get(), val.bn_.get(), ContextPool::GetBnCtx()));
   CHECK(BN_is_zero(rem.get())) << "Use DivAndTruncate() instead of Div() if "
                                   "you want truncated division.";
   return r;
 }
 
 BigNum BigNum::DivAndTruncate(const BigNum& val) const {
-  BigNum r(bn_ctx_);
-  BIGNUM* temp = BN_new();
-  CHECK_NE(temp, nullptr);
-  BignumPtr rem(temp);
+  BigNum r;
+  BignumPtr rem(ObjectPool::NewBignum());
   CRYPTO_CHECK(
-      1 == BN_div(r.bn_.get(), rem.get(), bn_.get(), val.bn_.get(), bn_ctx_));
+      1 == BN_div(r.bn_.get(), rem.get(), bn_.get(), val.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
@@ -198,57 +184,57 @@ int BigNum::CompareTo(const BigNum& val) const {
 }
 
 BigNum BigNum::Exp(const BigNum& exponent) const {
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(1 ==
-               BN_exp(r.bn_.get(), bn_.get(), exponent.bn_.get(), bn_ctx_));
+               BN_exp(r.bn_.get(), bn_.get(), exponent.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
 BigNum BigNum::Mod(const BigNum& m) const {
-  BigNum r(bn_ctx_);
-  CRYPTO_CHECK(1 == BN_nnmod(r.bn_.get(), bn_.get(), m.bn_.get(), bn_ctx_));
+  BigNum r;
+  CRYPTO_CHECK(1 == BN_nnmod(r.bn_.get(), bn_.get(), m.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
 BigNum BigNum::ModAdd(const BigNum& val, const BigNum& m) const {
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(1 == BN_mod_add(r.bn_.get(), bn_.get(), val.bn_.get(),
-                               m.bn_.get(), bn_ctx_));
+                               m.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
 BigNum BigNum::ModSub(const BigNum& val, const BigNum& m) const {
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(1 == BN_mod_sub(r.bn_.get(), bn_.get(), val.bn_.get(),
-                               m.bn_.get(), bn_ctx_));
+                               m.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
 BigNum BigNum::ModMul(const BigNum& val, const BigNum& m) const {
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(1 == BN_mod_mul(r.bn_.get(), bn_.get(), val.bn_.get(),
-                               m.bn_.get(), bn_ctx_));
+                               m.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
 BigNum BigNum::ModExp(const BigNum& exponent, const BigNum& m) const {
   CHECK(exponent.IsNonNegative()) << "Cannot use a negative exponent in BigNum "
                                      "ModExp.";
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(1 == BN_mod_exp(r.bn_.get(), bn_.get(), exponent.bn_.get(),
-                               m.bn_.get(), bn_ctx_));
+                               m.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
 BigNum BigNum::ModSqr(const BigNum& m) const {
-  BigNum r(bn_ctx_);
-  CRYPTO_CHECK(1 == BN_mod_sqr(r.bn_.get(), bn_.get(), m.bn_.get(), bn_ctx_));
+  BigNum r;
+  CRYPTO_CHECK(1 == BN_mod_sqr(r.bn_.get(), bn_.get(), m.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
 StatusOr<BigNum> BigNum::ModInverse(const BigNum& m) const {
-  BigNum r(bn_ctx_);
-  if (nullptr == BN_mod_inverse(r.bn_.get(), bn_.get(), m.bn_.get(), bn_ctx_)) {
+  BigNum r;
+  if (nullptr == BN_mod_inverse(r.bn_.get(), bn_.get(), m.bn_.get(), ContextPool::GetBnCtx())) {
     return InvalidArgumentError(
         absl::StrCat("BigNum::ModInverse failed: ", OpenSSLErrorString()));
   }
@@ -256,9 +242,9 @@ StatusOr<BigNum> BigNum::ModInverse(const BigNum& m) const {
 }
 
 BigNum BigNum::ModSqrt(const BigNum& m) const {
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(nullptr !=
-               BN_mod_sqrt(r.bn_.get(), bn_.get(), m.bn_.get(), bn_ctx_));
+               BN_mod_sqrt(r.bn_.get(), bn_.get(), m.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
@@ -270,20 +256,20 @@ BigNum BigNum::ModNegate(const BigNum& m) const {
 }
 
 BigNum BigNum::Lshift(int n) const {
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(1 == BN_lshift(r.bn_.get(), bn_.get(), n));
   return r;
 }
 
 BigNum BigNum::Rshift(int n) const {
-  BigNum r(bn_ctx_);
+  BigNum r;
   CRYPTO_CHECK(1 == BN_rshift(r.bn_.get(), bn_.get(), n));
   return r;
 }
 
 BigNum BigNum::Gcd(const BigNum& val) const {
-  BigNum r(bn_ctx_);
-  CRYPTO_CHECK(1 == BN_gcd(r.bn_.get(), bn_.get(), val.bn_.get(), bn_ctx_));
+  BigNum r;
+  CRYPTO_CHECK(1 == BN_gcd(r.bn_.get(), bn_.get(), val.bn_.get(), ContextPool::GetBnCtx()));
   return r;
 }
 
@@ -23,6 +23,7 @@
 #include <string>
 
 #include "absl/strings/string_view.h"
+#include "upsi/crypto/object_pool.h"
 #include "upsi/crypto/openssl.inc"
 #include "upsi/util/status.inc"
 
@@ -32,13 +33,14 @@ namespace upsi {
 // Used for arithmetic operations on big numbers.
 // Makes use of a BN_CTX structure that holds temporary BIGNUMs needed for
 // arithmetic operations as dynamic memory allocation to create BIGNUMs is
-// expensive.
+// expensive. The BN_CTX is the calling thread's one from ContextPool, so a
+// BigNum may be shared across threads as long as it is not mutated.
 class ABSL_MUST_USE_RESULT BigNum {
  public:
-  // Deletes a BIGNUM.
+  // Clears a BIGNUM and hands it back to the calling thread's ObjectPool.
   class BnDeleter {
    public:
-    void operator()(BIGNUM* bn) { BN_clear_free(bn); }
+    void operator()(BIGNUM* bn) { ObjectPool::FreeBignum(bn); }
   };
 
   // Deletes a BN_MONT_CTX.
@@ -180,18 +182,17 @@ class ABSL_MUST_USE_RESULT BigNum {
 
  private:
   // Creates a new BigNum object from a bytes string.
-  explicit BigNum(BN_CTX* bn_ctx, absl::string_view bytes);
+  explicit BigNum(absl::string_view bytes);
   // Creates a new BigNum object from a char array.
-  explicit BigNum(BN_CTX* bn_ctx, const unsigned char* bytes, int length);
+  explicit BigNum(const unsigned char* bytes, int length);
   // Creates a new BigNum object from the number.
-  explicit BigNum(BN_CTX* bn_ctx, uint64_t number);
+  explicit BigNum(uint64_t number);
   // Creates a new BigNum object with no defined value.
-  explicit BigNum(BN_CTX* bn_ctx);
+  BigNum();
   // Creates a new BigNum object from the given BIGNUM value.
-  explicit BigNum(BN_CTX* bn_ctx, BignumPtr bn);
+  explicit BigNum(BignumPtr bn);
 
   BignumPtr bn_;
-  BN_CTX* bn_ctx_;
 
   // Context is a factory for BigNum objects.
   friend class Context;
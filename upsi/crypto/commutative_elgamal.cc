@@ -35,7 +35,8 @@ CommutativeElGamal::CommutativeElGamal(
     : context_(std::move(ctx)),
       group_(std::move(group)),
       encrypter_(new ElGamalEncrypter(&group_, std::move(elgamal_public_key))),
-      decrypter_(new ElGamalDecrypter(std::move(elgamal_private_key))) {}
+      decrypter_(new ElGamalDecrypter(
+          context_.get(), &group_, std::move(elgamal_private_key))) {}
 
 CommutativeElGamal::CommutativeElGamal(
     std::unique_ptr<Context> ctx, ECGroup group,
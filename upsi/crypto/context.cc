@@ -40,6 +40,7 @@ Context::Context()
       three_bn_(CreateBigNum(3)) {
   OpenSSLInit();
   CHECK(RAND_status()) << "OpenSSL PRNG is not properly seeded.";
+  drbg_ = std::make_unique<Drbg>();
   HMAC_CTX_init(&hmac_ctx_);
 }
 
@@ -47,16 +48,26 @@ Context::~Context() { HMAC_CTX_cleanup(&hmac_ctx_); }
 
 BN_CTX* Context::GetBnCtx() { return bn_ctx_.get(); }
 
+Drbg* Context::GetDrbg() { return drbg_.get(); }
+
+Context* ContextPool::Get() {
+  thread_local std::unique_ptr<Context> context;
+  if (context == nullptr) {
+    context = std::make_unique<Context>();
+  }
+  return context.get();
+}
+
 BigNum Context::CreateBigNum(absl::string_view bytes) {
-  return BigNum(bn_ctx_.get(), bytes);
+  return BigNum(bytes);
 }
 
 BigNum Context::CreateBigNum(uint64_t number) {
-  return BigNum(bn_ctx_.get(), number);
+  return BigNum(number);
 }
 
 BigNum Context::CreateBigNum(BigNum::BignumPtr bn) {
-  return BigNum(bn_ctx_.get(), std::move(bn));
+  return BigNum(std::move(bn));
 }
 
 std::string Context::Sha256String(absl::string_view bytes) {
@@ -70,6 +81,28 @@ std::string Context::Sha256String(absl::string_view bytes) {
   return std::string(reinterpret_cast<char*>(hash), md_len);
 }
 
+std::vector<std::string> Context::Sha256Batch(
+    const std::vector<std::string>& inputs) {
+  // Initialising a digest looks the algorithm up again (an implicit fetch
+  // under OpenSSL 3); copying an initialised context does not.
+  EvpMdCtxPtr initialised(EVP_MD_CTX_create());
+  CRYPTO_CHECK(1 ==
+               EVP_DigestInit_ex(initialised.get(), EVP_sha256(), nullptr));
+  std::vector<std::string> hashes;
+  hashes.reserve(inputs.size());
+  unsigned char hash[EVP_MAX_MD_SIZE];
+  unsigned int md_len;
+  for (const std::string& input : inputs) {
+    CRYPTO_CHECK(1 ==
+                 EVP_MD_CTX_copy_ex(evp_md_ctx_.get(), initialised.get()));
+    CRYPTO_CHECK(
+        1 == EVP_DigestUpdate(evp_md_ctx_.get(), input.data(), input.size()));
+    CRYPTO_CHECK(1 == EVP_DigestFinal_ex(evp_md_ctx_.get(), hash, &md_len));
+    hashes.emplace_back(reinterpret_cast<char*>(hash), md_len);
+  }
+  return hashes;
+}
+
 std::string Context::Sha384String(absl::string_view bytes) {
   unsigned char hash[EVP_MAX_MD_SIZE];
   CRYPTO_CHECK(1 ==
@@ -140,6 +173,47 @@ BigNum Context::RandomOracleSha256(absl::string_view x,
   return RandomOracle(x, max_value, SHA256);
 }
 
+std::vector<BigNum> Context::RandomOracleSha256Batch(
+    const std::vector<std::string>& inputs, const BigNum& max_value) {
+  // Same expansion as RandomOracle: the hashes of i || x for i = 1, 2, ...
+  // concatenated are exactly the big-endian bytes of the accumulated sum.
+  const int hash_output_length = 256;
+  int output_bit_length = max_value.BitLength() + hash_output_length;
+  int iter_count =
+      std::ceil(static_cast<float>(output_bit_length) / hash_output_length);
+  CHECK(iter_count * hash_output_length < 130048)
+      << "The domain bit length must not be greater than "
+         "130048. Desired bit length: "
+      << output_bit_length;
+  int excess_bit_count = (iter_count * hash_output_length) - output_bit_length;
+
+  std::vector<std::string> prefixes;
+  for (int i = 1; i < iter_count + 1; i++) {
+    prefixes.push_back(CreateBigNum(i).ToBytes());
+  }
+  std::vector<std::string> blocks;
+  blocks.reserve(inputs.size() * iter_count);
+  for (const std::string& x : inputs) {
+    for (const std::string& prefix : prefixes) {
+      blocks.push_back(absl::StrCat(prefix, x));
+    }
+  }
+  std::vector<std::string> hashed = Sha256Batch(blocks);
+
+  std::vector<BigNum> outputs;
+  outputs.reserve(inputs.size());
+  for (size_t j = 0; j < inputs.size(); j++) {
+    std::string concatenated;
+    for (int i = 0; i < iter_count; i++) {
+      concatenated += hashed[j * iter_count + i];
+    }
+    outputs.push_back(CreateBigNum(concatenated)
+                          .Rshift(excess_bit_count)
+                          .Mod(max_value));
+  }
+  return outputs;
+}
+
 BigNum Context::PRF(absl::string_view key, absl::string_view data,
                     const BigNum& max_value) {
   CHECK_GE(key.size() * 8, 80);
@@ -156,7 +230,7 @@ BigNum Context::PRF(absl::string_view key, absl::string_view data,
   unsigned int md_len;
   unsigned char hash[EVP_MAX_MD_SIZE];
   CRYPTO_CHECK(1 == HMAC_Final(&hmac_ctx_, hash, &md_len));
-  BigNum hash_bn(bn_ctx_.get(), hash, md_len);
+  BigNum hash_bn(hash, md_len);
   BigNum hash_bn_reduced = hash_bn.GetLastNBits(max_value.BitLength());
   if (hash_bn_reduced < max_value) {
     return hash_bn_reduced;
@@ -166,23 +240,21 @@ BigNum Context::PRF(absl::string_view key, absl::string_view data,
 }
 
 BigNum Context::GenerateSafePrime(int prime_length) {
-  BigNum r(bn_ctx_.get());
+  BigNum r;
   CRYPTO_CHECK(1 == BN_generate_prime_ex(r.bn_.get(), prime_length, 1, nullptr,
                                          nullptr, nullptr));
   return r;
 }
 
 BigNum Context::GeneratePrime(int prime_length) {
-  BigNum r(bn_ctx_.get());
+  BigNum r;
   CRYPTO_CHECK(1 == BN_generate_prime_ex(r.bn_.get(), prime_length, 0, nullptr,
                                          nullptr, nullptr));
   return r;
 }
 
 BigNum Context::GenerateRandLessThan(const BigNum& max_value) {
-  BigNum r(bn_ctx_.get());
-  CRYPTO_CHECK(1 == BN_rand_range(r.bn_.get(), max_value.bn_.get()));
-  return r;
+  return drbg_->GenerateRandLessThan(max_value);
 }
 
 BigNum Context::GenerateRandBetween(const BigNum& start, const BigNum& end) {
@@ -193,9 +265,7 @@ BigNum Context::GenerateRandBetween(const BigNum& start, const BigNum& end) {
 std::string Context::GenerateRandomBytes(int num_bytes) {
   CHECK_GE(num_bytes, 0) << "num_bytes must be nonnegative, provided value was "
                          << num_bytes << ".";
-  std::unique_ptr<unsigned char[]> bytes(new unsigned char[num_bytes]);
-  CRYPTO_CHECK(1 == RAND_bytes(bytes.get(), num_bytes));
-  return std::string(reinterpret_cast<char*>(bytes.get()), num_bytes);
+  return drbg_->GenerateBytes(num_bytes);
 }
 
 BigNum Context::RelativelyPrimeRandomLessThan(const BigNum& num) {
@@ -20,10 +20,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/log/check.h"
 #include "absl/strings/string_view.h"
 #include "upsi/crypto/big_num.h"
+#include "upsi/crypto/drbg.h"
 #include "upsi/crypto/openssl.inc"
 
 #define CRYPTO_CHECK(expr) CHECK(expr) << OpenSSLErrorString();
@@ -40,7 +42,7 @@ std::string OpenSSLErrorString();
 // advantage of the BN_CTX structure for arithmetic operations.
 //
 // This class is not thread-safe, so each thread needs to have a unique Context
-// initialized.
+// initialized. ContextPool provides one per thread.
 class Context {
  public:
   // Deletes a BN_CTX.
@@ -69,6 +71,9 @@ class Context {
   // operations.
   BN_CTX* GetBnCtx();
 
+  // Returns the random bit generator backing the GenerateRand* methods.
+  Drbg* GetDrbg();
+
   // Creates a BigNum initialized with the given BIGNUM value.
   BigNum CreateBigNum(BigNum::BignumPtr bn);
 
@@ -81,6 +86,11 @@ class Context {
   // Hashes a string using SHA-256 to a byte string.
   virtual std::string Sha256String(absl::string_view bytes);
 
+  // Hashes every input using SHA-256; entry i of the result equals
+  // Sha256String(inputs[i]). Faster for many short inputs since the digest is
+  // set up once and cloned per input instead of being re-initialised.
+  std::vector<std::string> Sha256Batch(const std::vector<std::string>& inputs);
+
   // Hashes a string using SHA-384 to a byte string.
   virtual std::string Sha384String(absl::string_view bytes);
 
@@ -116,6 +126,12 @@ class Context {
   virtual BigNum RandomOracleSha512(absl::string_view x,
                                     const BigNum& max_value);
 
+  // Batched RandomOracleSha256: entry i of the result equals
+  // RandomOracleSha256(inputs[i], max_value). All the counter-prefixed blocks
+  // go through a single Sha256Batch call.
+  std::vector<BigNum> RandomOracleSha256Batch(
+      const std::vector<std::string>& inputs, const BigNum& max_value);
+
   // Evaluates a PRF keyed by 'key' on the given data. The returned value is
   // less than max_value.
   //
@@ -141,7 +157,7 @@ class Context {
   BigNum GeneratePrime(int prime_length);
 
   // Generates a cryptographically strong pseudo-random in the range [0,
-  // max_value).
+  // max_value), drawn from this Context's Drbg.
   // Marked virtual for tests.
   virtual BigNum GenerateRandLessThan(const BigNum& max_value);
 
@@ -166,6 +182,7 @@ class Context {
  private:
   BnCtxPtr bn_ctx_;
   EvpMdCtxPtr evp_md_ctx_;
+  std::unique_ptr<Drbg> drbg_;
   HMAC_CTX hmac_ctx_;
   const BigNum zero_bn_;
   const BigNum one_bn_;
@@ -183,6 +200,25 @@ class Context {
                               RandomOracleHashType hash_type);
 };
 
+// Hands out one Context per thread. Long-lived crypto objects (ECGroup,
+// ECPoint, BigNum, the Paillier and ElGamal wrappers) take their scratch space
+// from here rather than from the Context they were created with, so a single
+// instance can be shared by several worker threads.
+//
+// Each thread's Context is created on first use and destroyed when the thread
+// exits.
+class ContextPool {
+ public:
+  // Returns the calling thread's Context.
+  static Context* Get();
+
+  // Returns the calling thread's BN_CTX.
+  static BN_CTX* GetBnCtx() { return Get()->GetBnCtx(); }
+
+  // Returns the calling thread's random bit generator.
+  static Drbg* GetDrbg() { return Get()->GetDrbg(); }
+};
+
 }  // namespace upsi
 
 #endif  // upsi_CRYPTO_CONTEXT_H_
@@ -0,0 +1,144 @@
+#include "upsi/crypto/drbg.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "upsi/crypto/context.h"
+
+namespace upsi {
+
+namespace {
+
+// AES-CTR turns zeros into raw keystream.
+const unsigned char kZeros[4096] = {0};
+
+}  // namespace
+
+Drbg::Drbg() : cipher_ctx_(EVP_CIPHER_CTX_new()), reseed_(true) {
+  unsigned char key[kSeedLength];
+  CRYPTO_CHECK(1 == RAND_bytes(key, kSeedLength));
+  Seed(key);
+  OPENSSL_cleanse(key, kSeedLength);
+}
+
+Drbg::Drbg(absl::string_view seed)
+    : cipher_ctx_(EVP_CIPHER_CTX_new()), reseed_(false) {
+  CHECK_EQ(seed.size(), kSeedLength) << "Drbg seed must be 32 bytes";
+  Seed(reinterpret_cast<const unsigned char*>(seed.data()));
+}
+
+Drbg::~Drbg() { OPENSSL_cleanse(buffer_, kBufferSize); }
+
+void Drbg::Seed(const unsigned char* key) {
+  static_assert(sizeof(kZeros) >= kBufferSize, "kZeros is too short");
+  unsigned char iv[16] = {0};
+  CRYPTO_CHECK(1 == EVP_EncryptInit_ex(cipher_ctx_.get(), EVP_aes_256_ctr(),
+                                       nullptr, key, iv));
+  since_reseed_ = 0;
+  Refill();
+}
+
+void Drbg::Refill() {
+  int out_len = 0;
+  CRYPTO_CHECK(1 == EVP_EncryptUpdate(cipher_ctx_.get(), buffer_, &out_len,
+                                      kZeros, kBufferSize));
+  CHECK_EQ(static_cast<size_t>(out_len), kBufferSize);
+  position_ = 0;
+}
+
+void Drbg::Fill(unsigned char* out, size_t len) {
+  while (len > 0) {
+    if (position_ == kBufferSize) {
+      if (reseed_ && since_reseed_ >= kReseedInterval) {
+        unsigned char key[kSeedLength];
+        CRYPTO_CHECK(1 == RAND_bytes(key, kSeedLength));
+        Seed(key);
+        OPENSSL_cleanse(key, kSeedLength);
+      } else {
+        Refill();
+      }
+    }
+    size_t n = std::min(len, kBufferSize - position_);
+    memcpy(out, buffer_ + position_, n);
+    // Bytes handed out are erased so a later memory disclosure cannot
+    // recover them.
+    OPENSSL_cleanse(buffer_ + position_, n);
+    position_ += n;
+    since_reseed_ += n;
+    out += n;
+    len -= n;
+  }
+}
+
+std::string Drbg::GenerateBytes(size_t num_bytes) {
+  std::string bytes(num_bytes, '\0');
+  Fill(reinterpret_cast<unsigned char*>(&bytes[0]), num_bytes);
+  return bytes;
+}
+
+uint64_t Drbg::GenerateUint64() {
+  uint64_t value;
+  Fill(reinterpret_cast<unsigned char*>(&value), sizeof(value));
+  return value;
+}
+
+uint64_t Drbg::GenerateUint64LessThan(uint64_t bound) {
+  CHECK_GT(bound, 0u);
+  // Values below 2^64 mod bound would make the low residues more likely.
+  uint64_t threshold = -bound % bound;
+  uint64_t value;
+  do {
+    value = GenerateUint64();
+  } while (value < threshold);
+  return value % bound;
+}
+
+BigNum Drbg::GenerateRandLessThan(const BigNum& max_value) {
+  Context* ctx = ContextPool::Get();
+  CHECK(max_value > ctx->Zero());
+  int bits = max_value.BitLength();
+  size_t num_bytes = (bits + 7) / 8;
+  unsigned char top_mask = bits % 8 == 0 ? 0xff : (1 << (bits % 8)) - 1;
+  std::string bytes(num_bytes, '\0');
+  // Each draw succeeds with probability above 1/2.
+  while (true) {
+    Fill(reinterpret_cast<unsigned char*>(&bytes[0]), num_bytes);
+    bytes[0] &= top_mask;
+    BigNum candidate = ctx->CreateBigNum(bytes);
+    if (candidate < max_value) {
+      return candidate;
+    }
+  }
+}
+
+std::vector<BigNum> Drbg::GenerateRandLessThan(const BigNum& max_value,
+                                               size_t count) {
+  std::vector<BigNum> values;
+  values.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    values.push_back(GenerateRandLessThan(max_value));
+  }
+  return values;
+}
+
+std::vector<std::string> Drbg::GenerateHashes(size_t count, size_t length) {
+  std::string bytes = GenerateBytes(count * length);
+  std::vector<std::string> hashes;
+  hashes.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    hashes.push_back(bytes.substr(i * length, length));
+  }
+  return hashes;
+}
+
+std::vector<bool> Drbg::GenerateBits(size_t count) {
+  std::string bytes = GenerateBytes((count + 7) / 8);
+  std::vector<bool> bits(count);
+  for (size_t i = 0; i < count; i++) {
+    bits[i] = (bytes[i / 8] >> (i % 8)) & 1;
+  }
+  return bits;
+}
+
+}  // namespace upsi
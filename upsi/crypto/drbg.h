@@ -0,0 +1,109 @@
+#ifndef upsi_CRYPTO_DRBG_H_
+#define upsi_CRYPTO_DRBG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "upsi/crypto/big_num.h"
+#include "upsi/crypto/openssl.inc"
+
+namespace upsi {
+
+// Deterministic random bit generator that expands a 256-bit key with AES-CTR
+// (AES-NI where the CPU has it). The key is drawn from RAND_bytes when the
+// generator is created and again every kReseedInterval bytes, so drawing a
+// value costs a copy out of a keystream buffer rather than a RAND_bytes or
+// BN_rand_range call.
+//
+// Also satisfies UniformRandomBitGenerator, so it can drive std::shuffle.
+//
+// This class is not thread-safe. Every Context owns one, so the calling
+// thread's generator is ContextPool::GetDrbg().
+class Drbg {
+ public:
+  // Length in bytes of the key a Drbg can be seeded with.
+  static constexpr size_t kSeedLength = 32;
+
+  // Number of output bytes after which the key is replaced.
+  static constexpr uint64_t kReseedInterval = uint64_t{1} << 30;
+
+  // Creates a generator keyed from RAND_bytes.
+  Drbg();
+
+  // Creates a generator with a fixed kSeedLength-byte key that is never
+  // reseeded. Its output is reproducible, so it is only meant for tests.
+  explicit Drbg(absl::string_view seed);
+
+  // Drbg is neither copyable nor movable.
+  Drbg(const Drbg&) = delete;
+  Drbg& operator=(const Drbg&) = delete;
+
+  ~Drbg();
+
+  // Fills out with len pseudo-random bytes.
+  void Fill(unsigned char* out, size_t len);
+
+  // Returns num_bytes pseudo-random bytes.
+  std::string GenerateBytes(size_t num_bytes);
+
+  // Returns a uniformly random 64-bit value.
+  uint64_t GenerateUint64();
+
+  // Returns a uniformly random value in [0, bound). bound must be positive.
+  uint64_t GenerateUint64LessThan(uint64_t bound);
+
+  // Returns a uniformly random BigNum in [0, max_value), by rejection
+  // sampling. max_value must be positive.
+  BigNum GenerateRandLessThan(const BigNum& max_value);
+
+  // Returns count independent BigNums, each uniform in [0, max_value).
+  std::vector<BigNum> GenerateRandLessThan(const BigNum& max_value,
+                                           size_t count);
+
+  // Returns count random byte strings of the given length each; used for the
+  // random tree paths, which are shaped like SHA-256 outputs.
+  std::vector<std::string> GenerateHashes(size_t count, size_t length = 32);
+
+  // Returns count independent uniformly random bits.
+  std::vector<bool> GenerateBits(size_t count);
+
+  // UniformRandomBitGenerator interface.
+  using result_type = uint64_t;
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+  result_type operator()() { return GenerateUint64(); }
+
+ private:
+  // Deletes an EVP_CIPHER_CTX.
+  class EvpCipherCtxDeleter {
+   public:
+    void operator()(EVP_CIPHER_CTX* ctx) { EVP_CIPHER_CTX_free(ctx); }
+  };
+  typedef std::unique_ptr<EVP_CIPHER_CTX, EvpCipherCtxDeleter> EvpCipherCtxPtr;
+
+  static constexpr size_t kBufferSize = 4096;
+
+  // Keys the cipher and resets the counter.
+  void Seed(const unsigned char* key);
+
+  // Refills buffer_ with the next block of keystream.
+  void Refill();
+
+  EvpCipherCtxPtr cipher_ctx_;
+  unsigned char buffer_[kBufferSize];
+  size_t position_;
+  uint64_t since_reseed_;
+  bool reseed_;
+};
+
+}  // namespace upsi
+
+#endif  // upsi_CRYPTO_DRBG_H_
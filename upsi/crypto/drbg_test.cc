@@ -0,0 +1,80 @@
+#include "upsi/crypto/drbg.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "upsi/crypto/context.h"
+
+namespace upsi {
+namespace {
+
+const std::string kSeed(Drbg::kSeedLength, 'k');
+
+/**
+ * two generators with the same seed produce the same stream, regardless of
+ * how the draws are split up
+ */
+TEST(DrbgTest, SeededStreamIsReproducible) {
+    Drbg one(kSeed);
+    Drbg two(kSeed);
+
+    std::string whole = one.GenerateBytes(10000);
+    std::string parts = two.GenerateBytes(3);
+    parts += two.GenerateBytes(5000);
+    parts += two.GenerateBytes(4997);
+    EXPECT_EQ(whole, parts);
+
+    Drbg fresh;
+    EXPECT_NE(fresh.GenerateBytes(64), Drbg(kSeed).GenerateBytes(64));
+}
+
+/**
+ * bounded draws stay in range and hit both ends of a small range
+ */
+TEST(DrbgTest, GenerateLessThanStaysInRange) {
+    Context ctx;
+    Drbg drbg;
+
+    BigNum bound = ctx.CreateBigNum(257);
+    std::vector<BigNum> values = drbg.GenerateRandLessThan(bound, 5000);
+    ASSERT_EQ(values.size(), 5000);
+
+    bool saw_zero = false, saw_max = false;
+    for (const BigNum& value : values) {
+        EXPECT_TRUE(value < bound);
+        EXPECT_TRUE(value >= ctx.Zero());
+        saw_zero |= value == ctx.Zero();
+        saw_max |= value == ctx.CreateBigNum(256);
+    }
+    EXPECT_TRUE(saw_zero);
+    EXPECT_TRUE(saw_max);
+
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_LT(drbg.GenerateUint64LessThan(10), 10u);
+    }
+}
+
+/**
+ * bulk hashes and bits have the requested shape and are not constant
+ */
+TEST(DrbgTest, BulkShapes) {
+    Drbg drbg;
+
+    std::vector<std::string> hashes = drbg.GenerateHashes(100);
+    ASSERT_EQ(hashes.size(), 100);
+    for (const std::string& hash : hashes) { EXPECT_EQ(hash.size(), 32); }
+    EXPECT_NE(hashes[0], hashes[1]);
+
+    std::vector<bool> bits = drbg.GenerateBits(1001);
+    ASSERT_EQ(bits.size(), 1001);
+    size_t ones = 0;
+    for (bool bit : bits) { ones += bit; }
+    EXPECT_GT(ones, 400u);
+    EXPECT_LT(ones, 600u);
+}
+
+}  // namespace
+}  // namespace upsi
@@ -16,17 +16,24 @@
 #include "upsi/crypto/ec_group.h"
 
 #include <utility>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "upsi/crypto/ec_point.h"
+#include "upsi/crypto/object_pool.h"
 #include "upsi/crypto/openssl.inc"
+#include "upsi/util/parallel.h"
 #include "upsi/util/status.inc"
 
 namespace upsi {
 
 namespace {
 
+// Smallest number of multiplications handed to a worker thread by MulBatch;
+// below this handing the work to another thread costs more than it saves.
+constexpr size_t kMinMulBatchChunk = 32;
+
 // Returns a group using the predefined underlying operations suggested by
 // OpenSSL.
 StatusOr<ECGroup::ECGroupPtr> CreateGroup(int curve_id) {
@@ -113,11 +120,9 @@ BigNum GetPMinusOneOverTwo(const ECGroup::CurveParams& curve_params,
 
 }  // namespace
 
-ECGroup::ECGroup(Context* context, ECGroupPtr group, BigNum order,
-                 BigNum cofactor, CurveParams curve_params,
-                 BigNum p_minus_one_over_two)
-    : context_(context),
-      group_(std::move(group)),
+ECGroup::ECGroup(ECGroupPtr group, BigNum order, BigNum cofactor,
+                 CurveParams curve_params, BigNum p_minus_one_over_two)
+    : group_(std::move(group)),
       order_(std::move(order)),
       cofactor_(std::move(cofactor)),
       curve_params_(std::move(curve_params)),
@@ -129,16 +134,17 @@ StatusOr<ECGroup> ECGroup::Create(int curve_id, Context* context) {
   ASSIGN_OR_RETURN(BigNum cofactor, CreateCofactor(g.get(), context));
   ASSIGN_OR_RETURN(CurveParams params, CreateCurveParams(g.get(), context));
   BigNum p_minus_one_over_two = GetPMinusOneOverTwo(params, context);
-  return ECGroup(context, std::move(g), std::move(order), std::move(cofactor),
+  return ECGroup(std::move(g), std::move(order), std::move(cofactor),
                  std::move(params), std::move(p_minus_one_over_two));
 }
 
 BigNum ECGroup::GeneratePrivateKey() const {
-  return context_->GenerateRandBetween(context_->One(), order_);
+  Context* context = ContextPool::Get();
+  return context->GenerateRandBetween(context->One(), order_);
 }
 
 Status ECGroup::CheckPrivateKey(const BigNum& priv_key) const {
-  if (context_->Zero() >= priv_key || priv_key >= order_) {
+  if (ContextPool::Get()->Zero() >= priv_key || priv_key >= order_) {
     return InvalidArgumentError(
         "The given key is out of bounds, needs to be in [1, order) instead.");
   }
@@ -161,37 +167,40 @@ StatusOr<ECPoint> ECGroup::GetPointByHashingToCurveInternal(
 
 StatusOr<ECPoint> ECGroup::GetPointByHashingToCurveSha256(
     absl::string_view m) const {
-  BigNum x = context_->RandomOracleSha256(m, curve_params_.p);
+  Context* context = ContextPool::Get();
+  BigNum x = context->RandomOracleSha256(m, curve_params_.p);
   while (true) {
     auto status_or_point = GetPointByHashingToCurveInternal(x);
     if (status_or_point.ok()) {
       return status_or_point;
     }
-    x = context_->RandomOracleSha256(x.ToBytes(), curve_params_.p);
+    x = context->RandomOracleSha256(x.ToBytes(), curve_params_.p);
   }
 }
 
 StatusOr<ECPoint> ECGroup::GetPointByHashingToCurveSha384(
     absl::string_view m) const {
-  BigNum x = context_->RandomOracleSha384(m, curve_params_.p);
+  Context* context = ContextPool::Get();
+  BigNum x = context->RandomOracleSha384(m, curve_params_.p);
   while (true) {
     auto status_or_point = GetPointByHashingToCurveInternal(x);
     if (status_or_point.ok()) {
       return status_or_point;
     }
-    x = context_->RandomOracleSha384(x.ToBytes(), curve_params_.p);
+    x = context->RandomOracleSha384(x.ToBytes(), curve_params_.p);
   }
 }
 
 StatusOr<ECPoint> ECGroup::GetPointByHashingToCurveSha512(
     absl::string_view m) const {
-  BigNum x = context_->RandomOracleSha512(m, curve_params_.p);
+  Context* context = ContextPool::Get();
+  BigNum x = context->RandomOracleSha512(m, curve_params_.p);
   while (true) {
     auto status_or_point = GetPointByHashingToCurveInternal(x);
     if (status_or_point.ok()) {
       return status_or_point;
     }
-    x = context_->RandomOracleSha512(x.ToBytes(), curve_params_.p);
+    x = context->RandomOracleSha512(x.ToBytes(), curve_params_.p);
   }
 }
 
@@ -219,8 +228,58 @@ StatusOr<ECPoint> ECGroup::GetPointByHashingToCurveSswuRo(
   return out;
 }
 
+StatusOr<ECPoint> ECGroup::HashToCurve(absl::string_view m,
+                                       absl::string_view dst) const {
+  int curve_id = GetCurveId();
+  if (curve_id == NID_X9_62_prime256v1 || curve_id == NID_secp384r1) {
+    return GetPointByHashingToCurveSswuRo(m, dst);
+  }
+  return GetPointByHashingToCurveSha256(absl::StrCat(dst, m));
+}
+
+StatusOr<std::vector<ECPoint>> ECGroup::HashToCurveBatch(
+    absl::Span<const std::string> messages, absl::string_view dst) const {
+  std::vector<ECPoint> result;
+  result.reserve(messages.size());
+  for (size_t i = 0; i < messages.size(); i++) {
+    ASSIGN_OR_RETURN(ECPoint placeholder, GetPointAtInfinity());
+    result.push_back(std::move(placeholder));
+  }
+  RETURN_IF_ERROR(ParallelFor(
+      messages.size(), kMinMulBatchChunk,
+      [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+          ASSIGN_OR_RETURN(result[i], HashToCurve(messages[i], dst));
+        }
+        return OkStatus();
+      }));
+  return std::move(result);
+}
+
+StatusOr<std::vector<ECPoint>> ECGroup::HashToCurveAndMulBatch(
+    absl::Span<const std::string> messages, absl::string_view dst,
+    const BigNum& scalar) const {
+  std::vector<ECPoint> result;
+  result.reserve(messages.size());
+  for (size_t i = 0; i < messages.size(); i++) {
+    ASSIGN_OR_RETURN(ECPoint placeholder, GetPointAtInfinity());
+    result.push_back(std::move(placeholder));
+  }
+  RETURN_IF_ERROR(ParallelFor(
+      messages.size(), kMinMulBatchChunk,
+      [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+          ASSIGN_OR_RETURN(ECPoint point, HashToCurve(messages[i], dst));
+          ASSIGN_OR_RETURN(result[i], point.Mul(scalar));
+        }
+        return OkStatus();
+      }));
+  return std::move(result);
+}
+
 BigNum ECGroup::ComputeYSquare(const BigNum& x) const {
-  return (x.Exp(context_->Three()) + curve_params_.a * x + curve_params_.b)
+  return (x.Exp(ContextPool::Get()->Three()) + curve_params_.a * x +
+          curve_params_.b)
       .Mod(curve_params_.p);
 }
 
@@ -233,7 +292,7 @@ bool ECGroup::IsValid(const ECPoint& point) const {
 
 bool ECGroup::IsOnCurve(const ECPoint& point) const {
   return 1 == EC_POINT_is_on_curve(group_.get(), point.point_.get(),
-                                   context_->GetBnCtx());
+                                   ContextPool::GetBnCtx());
 }
 
 bool ECGroup::IsAtInfinity(const ECPoint& point) const {
@@ -250,18 +309,18 @@ StatusOr<ECPoint> ECGroup::GetFixedGenerator() const {
   if (dup_ssl_generator == nullptr) {
     return InternalError(OpenSSLErrorString());
   }
-  return ECPoint(group_.get(), context_->GetBnCtx(),
-                 ECPoint::ECPointPtr(dup_ssl_generator));
+  return ECPoint(group_.get(), ECPoint::ECPointPtr(dup_ssl_generator));
 }
 
 StatusOr<ECPoint> ECGroup::GetRandomGenerator() const {
   ASSIGN_OR_RETURN(ECPoint generator, GetFixedGenerator());
-  return generator.Mul(context_->GenerateRandBetween(context_->One(), order_));
+  Context* context = ContextPool::Get();
+  return generator.Mul(context->GenerateRandBetween(context->One(), order_));
 }
 
 StatusOr<ECPoint> ECGroup::CreateECPoint(const BigNum& x,
                                          const BigNum& y) const {
-  ECPoint point = ECPoint(group_.get(), context_->GetBnCtx(), x, y);
+  ECPoint point = ECPoint(group_.get(), x, y);
   if (!IsValid(point)) {
     return InvalidArgumentError(
         "ECGroup::CreateECPoint(x,y) - The point is not valid.");
@@ -270,20 +329,20 @@ StatusOr<ECPoint> ECGroup::CreateECPoint(const BigNum& x,
 }
 
 StatusOr<ECPoint> ECGroup::CreateECPoint(absl::string_view bytes) const {
-  auto raw_ec_point_ptr = EC_POINT_new(group_.get());
+  auto raw_ec_point_ptr = ObjectPool::NewPoint(group_.get());
   if (raw_ec_point_ptr == nullptr) {
     return InternalError("ECGroup::CreateECPoint: Failed to create point.");
   }
   ECPoint::ECPointPtr point(raw_ec_point_ptr);
   if (EC_POINT_oct2point(group_.get(), point.get(),
                          reinterpret_cast<const unsigned char*>(bytes.data()),
-                         bytes.size(), context_->GetBnCtx()) != 1) {
+                         bytes.size(), ContextPool::GetBnCtx()) != 1) {
     return InvalidArgumentError(
         absl::StrCat("ECGroup::CreateECPoint(string) - Could not decode point.",
                      "\n", OpenSSLErrorString()));
   }
 
-  ECPoint ec_point(group_.get(), context_->GetBnCtx(), std::move(point));
+  ECPoint ec_point(group_.get(), std::move(point));
   if (!IsValid(ec_point)) {
     return InvalidArgumentError(
         "ECGroup::CreateECPoint(string) - Decoded point is not valid.");
@@ -292,18 +351,43 @@ StatusOr<ECPoint> ECGroup::CreateECPoint(absl::string_view bytes) const {
 }
 
 StatusOr<ECPoint> ECGroup::GetPointAtInfinity() const {
-  EC_POINT* new_point = EC_POINT_new(group_.get());
+  EC_POINT* new_point = ObjectPool::NewPoint(group_.get());
   if (new_point == nullptr) {
     return InternalError(
         "ECGroup::GetPointAtInfinity() - Could not create new point.");
   }
-  ECPoint::ECPointPtr point(new_point);
-  if (EC_POINT_set_to_infinity(group_.get(), point.get()) != 1) {
-    return InternalError(
-        "ECGroup::GetPointAtInfinity() - Could not get point at infinity.");
+  // Fresh and recycled points are both already at infinity.
+  return ECPoint(group_.get(), ECPoint::ECPointPtr(new_point));
+}
+
+StatusOr<std::vector<ECPoint>> ECGroup::MulBatch(
+    absl::Span<const ECPoint> points, absl::Span<const BigNum> scalars) const {
+  if (points.size() != scalars.size()) {
+    return InvalidArgumentError(
+        "ECGroup::MulBatch() - number of scalars does not match number of "
+        "points.");
   }
-  ECPoint ec_point(group_.get(), context_->GetBnCtx(), std::move(point));
-  return std::move(ec_point);
+  std::vector<ECPoint> result;
+  result.reserve(points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    ASSIGN_OR_RETURN(ECPoint placeholder, GetPointAtInfinity());
+    result.push_back(std::move(placeholder));
+  }
+  RETURN_IF_ERROR(ParallelFor(
+      points.size(), kMinMulBatchChunk,
+      [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+          ASSIGN_OR_RETURN(result[i], points[i].Mul(scalars[i]));
+        }
+        return OkStatus();
+      }));
+  return std::move(result);
+}
+
+StatusOr<std::vector<ECPoint>> ECGroup::MulBatch(
+    absl::Span<const ECPoint> points, const BigNum& scalar) const {
+  std::vector<BigNum> scalars(points.size(), scalar);
+  return MulBatch(points, scalars);
 }
 
 }  // namespace upsi
@@ -18,8 +18,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "upsi/crypto/big_num.h"
 #include "upsi/crypto/context.h"
 #include "upsi/crypto/openssl.inc"
@@ -45,6 +47,9 @@ class ECGroup {
   // NIST. Returns INTERNAL error code if there is a failure in crypto
   // operations. Security: this function is secure only for prime order curves.
   // (All supported curves in BoringSSL have prime order.)
+  //
+  // The context is only used during construction; afterwards the group draws
+  // on ContextPool and may be shared across threads.
   static StatusOr<ECGroup> Create(int curve_id, Context* context);
 
   // Generates a new private key. The private key is a cryptographically strong
@@ -69,6 +74,20 @@ class ECGroup {
   StatusOr<ECPoint> GetPointByHashingToCurveSswuRo(absl::string_view m,
                                                    absl::string_view dst) const;
 
+  // Hashes every message to the curve and returns the points. Uses the
+  // constant-time SSWU random-oracle map under the domain separation tag dst
+  // on curves that have one (P-256, P-384) and falls back to
+  // GetPointByHashingToCurveSha256 of dst || m elsewhere. The batch is split
+  // across worker threads like MulBatch.
+  StatusOr<std::vector<ECPoint>> HashToCurveBatch(
+      absl::Span<const std::string> messages, absl::string_view dst) const;
+
+  // As above, returning H(messages[i]) * scalar for every i. The hash and the
+  // multiplication run in the same worker pass.
+  StatusOr<std::vector<ECPoint>> HashToCurveAndMulBatch(
+      absl::Span<const std::string> messages, absl::string_view dst,
+      const BigNum& scalar) const;
+
   // Returns y^2 for the given x. The returned value is computed as x^3 + ax + b
   // mod p, where a and b are the parameters of the curve.
   BigNum ComputeYSquare(const BigNum& x) const;
@@ -107,8 +126,20 @@ class ECGroup {
   // Creates an ECPoint which is the identity.
   StatusOr<ECPoint> GetPointAtInfinity() const;
 
+  // Returns points[i] * scalars[i] for every i. The multiplications are
+  // independent, so the batch is split across worker threads once it is large
+  // enough to pay for them; each lane runs the same OpenSSL multiplication as
+  // ECPoint::Mul, so results are identical to the one-at-a-time path.
+  // Returns an INVALID_ARGUMENT error code if the sizes do not match.
+  StatusOr<std::vector<ECPoint>> MulBatch(absl::Span<const ECPoint> points,
+                                          absl::Span<const BigNum> scalars) const;
+
+  // As above, multiplying every point by the same scalar.
+  StatusOr<std::vector<ECPoint>> MulBatch(absl::Span<const ECPoint> points,
+                                          const BigNum& scalar) const;
+
  private:
-  ECGroup(Context* context, ECGroupPtr group, BigNum order, BigNum cofactor,
+  ECGroup(ECGroupPtr group, BigNum order, BigNum cofactor,
           CurveParams curve_params, BigNum p_minus_one_over_two);
 
   // Creates an ECPoint object with the given x, y affine coordinates.
@@ -129,7 +160,6 @@ class ECGroup {
   // Returns true if the given point is at infinity.
   bool IsAtInfinity(const ECPoint& point) const;
 
-  Context* context_;
   ECGroupPtr group_;
   // The order of this group.
   BigNum order_;
@@ -142,6 +172,10 @@ class ECGroup {
   BigNum p_minus_one_over_two_;
 
   StatusOr<ECPoint> GetPointByHashingToCurveInternal(const BigNum& x) const;
+
+  // The per-message map used by HashToCurveBatch.
+  StatusOr<ECPoint> HashToCurve(absl::string_view m,
+                                absl::string_view dst) const;
 };
 
 }  // namespace upsi
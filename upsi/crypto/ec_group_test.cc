@@ -0,0 +1,211 @@
+#include "upsi/crypto/ec_group.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+
+#include "upsi/crypto/context.h"
+#include "upsi/crypto/ec_point.h"
+#include "upsi/util/status_testing.inc"
+
+namespace upsi {
+namespace {
+
+using ::testing::HasSubstr;
+using testing::IsOkAndHolds;
+using testing::StatusIs;
+
+const int kTestCurveId = NID_X9_62_prime256v1;
+
+const char kTestDst[] = "upsi-test";
+
+/**
+ * test vector from RFC 9380, appendix J.1.1: P256_XMD:SHA-256_SSWU_RO_ applied
+ * to the empty message, as an uncompressed point
+ */
+const char kSswuDst[] = "QUUX-V01-CS02-with-P256_XMD:SHA-256_SSWU_RO_";
+const char kSswuEmptyMessage[] =
+    "04"
+    "2c15230b26dbc6fc9a37051158c95b79656e17a1a920b11394ca91c44247d3e4"
+    "8a7a74985cc5c776cdfe4b1f19884970453912e9d31528c060be9ab5c43e8415";
+
+std::vector<std::string> TestMessages(size_t size) {
+    std::vector<std::string> messages;
+    for (size_t i = 0; i < size; i++) {
+        messages.push_back(absl::StrCat("message ", i));
+    }
+    return messages;
+}
+
+/**
+ * batched multiplications match one-at-a-time ones, for batches below and
+ * well above the size that is split across workers
+ */
+TEST(ECGroupTest, MulBatchMatchesMul) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(ECGroup group, ECGroup::Create(kTestCurveId, &ctx));
+    ASSERT_OK_AND_ASSIGN(ECPoint g, group.GetFixedGenerator());
+
+    for (size_t size : { 0, 1, 5, 200 }) {
+        std::vector<ECPoint> points;
+        std::vector<BigNum> scalars;
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_OK_AND_ASSIGN(ECPoint point, g.Mul(group.GeneratePrivateKey()));
+            points.push_back(std::move(point));
+            scalars.push_back(group.GeneratePrivateKey());
+        }
+        BigNum scalar = group.GeneratePrivateKey();
+
+        ASSERT_OK_AND_ASSIGN(std::vector<ECPoint> each, group.MulBatch(points, scalars));
+        ASSERT_OK_AND_ASSIGN(std::vector<ECPoint> same, group.MulBatch(points, scalar));
+        ASSERT_EQ(each.size(), size);
+        ASSERT_EQ(same.size(), size);
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_OK_AND_ASSIGN(ECPoint expected, points[i].Mul(scalars[i]));
+            EXPECT_EQ(each[i], expected);
+            ASSERT_OK_AND_ASSIGN(expected, points[i].Mul(scalar));
+            EXPECT_EQ(same[i], expected);
+        }
+    }
+}
+
+/**
+ * a scalar for every point is required
+ */
+TEST(ECGroupTest, MulBatchRejectsSizeMismatch) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(ECGroup group, ECGroup::Create(kTestCurveId, &ctx));
+    ASSERT_OK_AND_ASSIGN(ECPoint g, group.GetFixedGenerator());
+
+    std::vector<ECPoint> points;
+    points.push_back(std::move(g));
+    std::vector<BigNum> scalars;
+    EXPECT_THAT(
+        group.MulBatch(points, scalars),
+        StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("does not match"))
+    );
+}
+
+/**
+ * hashed points are valid, depend only on the message and the tag, and the
+ * batch agrees with hashing one message at a time
+ */
+TEST(ECGroupTest, HashToCurveBatchIsDeterministic) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(ECGroup group, ECGroup::Create(kTestCurveId, &ctx));
+
+    for (size_t size : { 0, 1, 5, 200 }) {
+        std::vector<std::string> messages = TestMessages(size);
+        ASSERT_OK_AND_ASSIGN(
+            std::vector<ECPoint> points, group.HashToCurveBatch(messages, kTestDst)
+        );
+        ASSERT_OK_AND_ASSIGN(
+            std::vector<ECPoint> again, group.HashToCurveBatch(messages, kTestDst)
+        );
+        ASSERT_OK_AND_ASSIGN(
+            std::vector<ECPoint> other, group.HashToCurveBatch(messages, "upsi-other")
+        );
+        ASSERT_EQ(points.size(), size);
+        for (size_t i = 0; i < size; i++) {
+            // decoding checks that the point is on the curve
+            ASSERT_OK_AND_ASSIGN(std::string bytes, points[i].ToBytesUnCompressed());
+            EXPECT_OK(group.CreateECPoint(bytes));
+            EXPECT_EQ(points[i], again[i]);
+            EXPECT_NE(points[i], other[i]);
+            if (i > 0) { EXPECT_NE(points[i], points[i - 1]); }
+
+            ASSERT_OK_AND_ASSIGN(
+                std::vector<ECPoint> single,
+                group.HashToCurveBatch(absl::MakeConstSpan(&messages[i], 1), kTestDst)
+            );
+            EXPECT_EQ(points[i], single[0]);
+        }
+    }
+}
+
+/**
+ * the fused hash and multiplication matches hashing and then multiplying
+ */
+TEST(ECGroupTest, HashToCurveAndMulBatchMatchesHashThenMul) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(ECGroup group, ECGroup::Create(kTestCurveId, &ctx));
+    BigNum scalar = group.GeneratePrivateKey();
+
+    for (size_t size : { 0, 1, 5, 200 }) {
+        std::vector<std::string> messages = TestMessages(size);
+        ASSERT_OK_AND_ASSIGN(
+            std::vector<ECPoint> points, group.HashToCurveBatch(messages, kTestDst)
+        );
+        ASSERT_OK_AND_ASSIGN(
+            std::vector<ECPoint> fused,
+            group.HashToCurveAndMulBatch(messages, kTestDst, scalar)
+        );
+        ASSERT_EQ(fused.size(), size);
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_OK_AND_ASSIGN(ECPoint expected, points[i].Mul(scalar));
+            EXPECT_EQ(fused[i], expected);
+        }
+    }
+}
+
+/**
+ * on P-256 the hash is the SSWU random-oracle map (checked against the RFC
+ * test vector), not the SHA-256 try-and-increment fallback
+ */
+TEST(ECGroupTest, HashToCurveUsesSswuOnP256) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(ECGroup group, ECGroup::Create(kTestCurveId, &ctx));
+
+    std::vector<std::string> messages = { "" };
+    ASSERT_OK_AND_ASSIGN(
+        std::vector<ECPoint> points, group.HashToCurveBatch(messages, kSswuDst)
+    );
+    EXPECT_THAT(
+        points[0].ToBytesUnCompressed(),
+        IsOkAndHolds(absl::HexStringToBytes(kSswuEmptyMessage))
+    );
+
+    messages = TestMessages(5);
+    ASSERT_OK_AND_ASSIGN(points, group.HashToCurveBatch(messages, kTestDst));
+    for (size_t i = 0; i < messages.size(); i++) {
+        ASSERT_OK_AND_ASSIGN(
+            ECPoint sswu, group.GetPointByHashingToCurveSswuRo(messages[i], kTestDst)
+        );
+        ASSERT_OK_AND_ASSIGN(
+            ECPoint fallback,
+            group.GetPointByHashingToCurveSha256(absl::StrCat(kTestDst, messages[i]))
+        );
+        EXPECT_EQ(points[i], sswu);
+        EXPECT_NE(points[i], fallback);
+    }
+}
+
+/**
+ * curves without an SSWU map hash dst || m with SHA-256
+ */
+TEST(ECGroupTest, HashToCurveFallsBackToSha256) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(ECGroup group, ECGroup::Create(NID_secp224r1, &ctx));
+
+    std::vector<std::string> messages = TestMessages(5);
+    ASSERT_OK_AND_ASSIGN(
+        std::vector<ECPoint> points, group.HashToCurveBatch(messages, kTestDst)
+    );
+    for (size_t i = 0; i < messages.size(); i++) {
+        ASSERT_OK_AND_ASSIGN(
+            ECPoint expected,
+            group.GetPointByHashingToCurveSha256(absl::StrCat(kTestDst, messages[i]))
+        );
+        ASSERT_OK_AND_ASSIGN(std::string bytes, points[i].ToBytesUnCompressed());
+        EXPECT_OK(group.CreateECPoint(bytes));
+        EXPECT_EQ(points[i], expected);
+    }
+}
+
+}  // namespace
+}  // namespace upsi
@@ -23,35 +23,42 @@
 #include "absl/strings/str_cat.h"
 #include "upsi/crypto/big_num.h"
 #include "upsi/crypto/context.h"
+#include "upsi/crypto/object_pool.h"
 #include "upsi/crypto/openssl.inc"
 #include "upsi/util/status.inc"
 
 namespace upsi {
 
-ECPoint::ECPoint(const EC_GROUP* group, BN_CTX* bn_ctx)
-    : bn_ctx_(bn_ctx), group_(group) {
-  point_ = ECPointPtr(EC_POINT_new(group_));
-}
+ECPoint::ECPoint(const EC_GROUP* group)
+    : group_(group), point_(ObjectPool::NewPoint(group)) {}
 
-ECPoint::ECPoint(const EC_GROUP* group, BN_CTX* bn_ctx, const BigNum& x,
-                 const BigNum& y)
-    : ECPoint::ECPoint(group, bn_ctx) {
+ECPoint::ECPoint(const EC_GROUP* group, const BigNum& x, const BigNum& y)
+    : ECPoint::ECPoint(group) {
   CRYPTO_CHECK(1 == EC_POINT_set_affine_coordinates_GFp(
                         group_, point_.get(), x.GetConstBignumPtr(),
-                        y.GetConstBignumPtr(), bn_ctx_));
+                        y.GetConstBignumPtr(), ContextPool::GetBnCtx()));
 }
 
-ECPoint::ECPoint(const EC_GROUP* group, BN_CTX* bn_ctx, ECPointPtr point)
-    : ECPoint::ECPoint(group, bn_ctx) {
-  point_ = std::move(point);
+ECPoint::ECPoint(const EC_GROUP* group, ECPointPtr point)
+    : group_(group), point_(std::move(point)) {}
+
+ECPoint& ECPoint::operator=(ECPoint&& that) {
+  if (this != &that) {
+    ObjectPool::FreePoint(group_, point_.release());
+    group_ = that.group_;
+    point_ = std::move(that.point_);
+  }
+  return *this;
 }
 
+ECPoint::~ECPoint() { ObjectPool::FreePoint(group_, point_.release()); }
+
 StatusOr<std::string> ECPoint::ToBytesCompressed() const {
   int length = EC_POINT_point2oct(
-      group_, point_.get(), POINT_CONVERSION_COMPRESSED, nullptr, 0, bn_ctx_);
+      group_, point_.get(), POINT_CONVERSION_COMPRESSED, nullptr, 0, ContextPool::GetBnCtx());
   std::vector<unsigned char> bytes(length);
   if (0 == EC_POINT_point2oct(group_, point_.get(), POINT_CONVERSION_COMPRESSED,
-                              bytes.data(), length, bn_ctx_)) {
+                              bytes.data(), length, ContextPool::GetBnCtx())) {
     return InternalError(
         absl::StrCat("EC_POINT_point2oct failed:", OpenSSLErrorString()));
   }
@@ -60,11 +67,11 @@ StatusOr<std::string> ECPoint::ToBytesCompressed() const {
 
 StatusOr<std::string> ECPoint::ToBytesUnCompressed() const {
   int length = EC_POINT_point2oct(
-      group_, point_.get(), POINT_CONVERSION_UNCOMPRESSED, nullptr, 0, bn_ctx_);
+      group_, point_.get(), POINT_CONVERSION_UNCOMPRESSED, nullptr, 0, ContextPool::GetBnCtx());
   std::vector<unsigned char> bytes(length);
   if (0 == EC_POINT_point2oct(group_, point_.get(),
                               POINT_CONVERSION_UNCOMPRESSED, bytes.data(),
-                              length, bn_ctx_)) {
+                              length, ContextPool::GetBnCtx())) {
     return InternalError(
         absl::StrCat("EC_POINT_point2oct failed:", OpenSSLErrorString()));
   }
@@ -72,9 +79,9 @@ StatusOr<std::string> ECPoint::ToBytesUnCompressed() const {
 }
 
 StatusOr<ECPoint> ECPoint::Mul(const BigNum& scalar) const {
-  ECPoint r = ECPoint(group_, bn_ctx_);
+  ECPoint r = ECPoint(group_);
   if (1 != EC_POINT_mul(group_, r.point_.get(), nullptr, point_.get(),
-                        scalar.GetConstBignumPtr(), bn_ctx_)) {
+                        scalar.GetConstBignumPtr(), ContextPool::GetBnCtx())) {
     return InternalError(
         absl::StrCat("EC_POINT_mul failed:", OpenSSLErrorString()));
   }
@@ -82,9 +89,9 @@ StatusOr<ECPoint> ECPoint::Mul(const BigNum& scalar) const {
 }
 
 StatusOr<ECPoint> ECPoint::Add(const ECPoint& point) const {
-  ECPoint r = ECPoint(group_, bn_ctx_);
+  ECPoint r = ECPoint(group_);
   if (1 != EC_POINT_add(group_, r.point_.get(), point_.get(),
-                        point.point_.get(), bn_ctx_)) {
+                        point.point_.get(), ContextPool::GetBnCtx())) {
     return InternalError(
         absl::StrCat("EC_POINT_add failed:", OpenSSLErrorString()));
   }
@@ -92,7 +99,7 @@ StatusOr<ECPoint> ECPoint::Add(const ECPoint& point) const {
 }
 
 StatusOr<ECPoint> ECPoint::Clone() const {
-  ECPoint r = ECPoint(group_, bn_ctx_);
+  ECPoint r = ECPoint(group_);
   if (1 != EC_POINT_copy(r.point_.get(), point_.get())) {
     return InternalError(
         absl::StrCat("EC_POINT_copy failed:", OpenSSLErrorString()));
@@ -104,7 +111,7 @@ StatusOr<ECPoint> ECPoint::Inverse() const {
   // Create a copy of this.
   ASSIGN_OR_RETURN(ECPoint inv, Clone());
   // Invert the copy in-place.
-  if (1 != EC_POINT_invert(group_, inv.point_.get(), bn_ctx_)) {
+  if (1 != EC_POINT_invert(group_, inv.point_.get(), ContextPool::GetBnCtx())) {
     return InternalError(
         absl::StrCat("EC_POINT_invert failed:", OpenSSLErrorString()));
   }
@@ -116,7 +123,7 @@ bool ECPoint::IsPointAtInfinity() const {
 }
 
 bool ECPoint::CompareTo(const ECPoint& point) const {
-  return 0 == EC_POINT_cmp(group_, point_.get(), point.point_.get(), bn_ctx_);
+  return 0 == EC_POINT_cmp(group_, point_.get(), point.point_.get(), ContextPool::GetBnCtx());
 }
 
 std::string ECPoint::Print() const {
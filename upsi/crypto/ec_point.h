@@ -39,12 +39,15 @@ class ECPoint {
 
   // ECPoint is movable.
   ECPoint(ECPoint&& that) = default;
-  ECPoint& operator=(ECPoint&& that) = default;
+  ECPoint& operator=(ECPoint&& that);
 
   // ECPoint is not copyable. Use Clone to copy, instead.
   explicit ECPoint(const ECPoint& that) = delete;
   ECPoint& operator=(const ECPoint& that) = delete;
 
+  // Hands the underlying EC_POINT back to the calling thread's ObjectPool.
+  ~ECPoint();
+
   // Converts this point to octet string in compressed form as defined in ANSI
   // X9.62 ECDSA.
   StatusOr<std::string> ToBytesCompressed() const;
@@ -80,16 +83,15 @@ class ECPoint {
 
  private:
   // Creates an ECPoint on the given group;
-  ECPoint(const EC_GROUP* group, BN_CTX* bn_ctx);
+  explicit ECPoint(const EC_GROUP* group);
 
   // Creates an ECPoint on the given group from the given EC_POINT;
-  ECPoint(const EC_GROUP* group, BN_CTX* bn_ctx, ECPointPtr point);
+  ECPoint(const EC_GROUP* group, ECPointPtr point);
 
   // Creates an ECPoint object with the given x, y affine coordinates.
-  ECPoint(const EC_GROUP* group, BN_CTX* bn_ctx, const BigNum& x,
-          const BigNum& y);
+  ECPoint(const EC_GROUP* group, const BigNum& x, const BigNum& y);
 
-  BN_CTX* bn_ctx_;
+  // Operations use the calling thread's BN_CTX from ContextPool.
   const EC_GROUP* group_;
   ECPointPtr point_;
 
@@ -144,8 +144,11 @@ BigNum ElGamalEncrypter::CreateRandomMask() const {
 
 ElGamalDecrypter::ElGamalDecrypter(
     Context* ctx,
+    const ECGroup* ec_group,
     std::unique_ptr<elgamal::PrivateKey> elgamal_private_key
-) : private_key_(std::move(elgamal_private_key)), ctx_(ctx) {}
+) : private_key_(std::move(elgamal_private_key)),
+    minus_x_(ec_group->GetOrder().ModSub(private_key_->x, ec_group->GetOrder())),
+    ctx_(ctx) {}
 
 Status ElGamalDecrypter::InitDecryptExp(const elgamal::PublicKey* pk, uint64_t exp_limit) {
     ASSIGN_OR_RETURN(ECPoint g, pk->g.Clone());
@@ -165,6 +168,14 @@ StatusOr<ECPoint> ElGamalDecrypter::Decrypt(
   return {std::move(message)};
 }
 
+StatusOr<bool> ElGamalDecrypter::IsEncryptionOfZero(
+    const elgamal::Ciphertext& ciphertext) const {
+  // e * (u^x)^-1 is the point at infinity iff e == u^x. The comparison is
+  // done on projective coordinates, so it needs no field inversion.
+  ASSIGN_OR_RETURN(ECPoint u_to_x, ciphertext.u.Mul(private_key_->x));
+  return ciphertext.e.CompareTo(u_to_x);
+}
+
 StatusOr<elgamal::Ciphertext> ElGamalDecrypter::PartialDecrypt(
     const elgamal::Ciphertext& ciphertext) const {
   ASSIGN_OR_RETURN(ECPoint clone_u, ciphertext.u.Clone());
@@ -172,6 +183,15 @@ StatusOr<elgamal::Ciphertext> ElGamalDecrypter::PartialDecrypt(
   return {{std::move(clone_u), std::move(dec_e)}};
 }
 
+StatusOr<elgamal::Ciphertext> ElGamalDecrypter::MaskAndPartialDecrypt(
+    const elgamal::Ciphertext& ciphertext, const BigNum& mask) const {
+  // u' = u^a , e' = e^a * u'^(order - x) .
+  ASSIGN_OR_RETURN(ECPoint u, ciphertext.u.Mul(mask));
+  ASSIGN_OR_RETURN(ECPoint e_to_mask, ciphertext.e.Mul(mask));
+  ASSIGN_OR_RETURN(ECPoint u_to_minus_x, u.Mul(minus_x_));
+  ASSIGN_OR_RETURN(ECPoint e, e_to_mask.Add(u_to_minus_x));
+  return {{std::move(u), std::move(e)}};
+}
 
 StatusOr<BigNum> ElGamalDecrypter::DecryptExp(const elgamal::Ciphertext& ciphertext) const {
     if (this->exponents_.size() == 0) {
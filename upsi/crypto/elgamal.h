@@ -142,10 +142,11 @@ class ElGamalEncrypter {
 // Implements ElGamal decryption using the private key.
 class ElGamalDecrypter {
  public:
-  // Creates a ElGamalDecrypter object from a given private key.
+  // Creates a ElGamalDecrypter object from a given private key over ec_group.
   // Takes ownership of the private key.
-  explicit ElGamalDecrypter(
+  ElGamalDecrypter(
       Context* ctx,
+      const ECGroup* ec_group,
       std::unique_ptr<elgamal::PrivateKey> elgamal_private_key
   );
 
@@ -161,6 +162,11 @@ class ElGamalDecrypter {
   // Decrypts a given ElGamal ciphertext to a group element.
   StatusOr<ECPoint> Decrypt(const elgamal::Ciphertext& ciphertext) const;
 
+  // Returns true if the given ciphertext decrypts to the point at infinity.
+  // Cheaper than Decrypt followed by IsPointAtInfinity: u^x is compared
+  // against e directly, without inverting or adding points.
+  StatusOr<bool> IsEncryptionOfZero(const elgamal::Ciphertext& ciphertext) const;
+
   // Decrypts a given ElGamal ciphertext to its exponent.
   StatusOr<BigNum> DecryptExp(const elgamal::Ciphertext& ciphertext) const;
 
@@ -169,6 +175,14 @@ class ElGamalDecrypter {
   // partial public keys.
   StatusOr<elgamal::Ciphertext> PartialDecrypt(const elgamal::Ciphertext& ciphertext) const;
 
+  // Homomorphically exponentiates a ciphertext by mask and partially decrypts
+  // the result, i.e. returns (u^mask, e^mask * (u^mask)^(order - x)).
+  // Equivalent to PartialDecrypt(elgamal::Exp(ciphertext, mask)), but the
+  // inversion is folded into the precomputed scalar order - x, which keeps
+  // every scalar in [0, order).
+  StatusOr<elgamal::Ciphertext> MaskAndPartialDecrypt(
+      const elgamal::Ciphertext& ciphertext, const BigNum& mask) const;
+
   // Returns a pointer to the owned ElGamal private key
   const elgamal::PrivateKey* getPrivateKey() const {
     return private_key_.get();
@@ -177,6 +191,9 @@ class ElGamalDecrypter {
  private:
   std::unique_ptr<elgamal::PrivateKey> private_key_;
 
+  // order - x, used in place of -x so that no scalar is ever negative
+  BigNum minus_x_;
+
   // for exponential decryption
   Context* ctx_;
   std::vector<ECPoint> exponents_;
@@ -0,0 +1,93 @@
+#include "upsi/crypto/elgamal.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "upsi/crypto/context.h"
+#include "upsi/crypto/ec_group.h"
+#include "upsi/util/status_testing.inc"
+
+namespace upsi {
+namespace {
+
+using testing::IsOkAndHolds;
+
+const int kTestCurveId = NID_X9_62_prime256v1;
+
+class ElGamalTest : public ::testing::Test {
+    protected:
+        ElGamalTest() : group(ECGroup::Create(kTestCurveId, &ctx).value()) {
+            auto keys = elgamal::GenerateKeyPair(group).value();
+            encrypter = std::make_unique<ElGamalEncrypter>(&group, std::move(keys.first));
+            decrypter = std::make_unique<ElGamalDecrypter>(
+                &ctx, &group, std::move(keys.second)
+            );
+        }
+
+        Context ctx;
+        ECGroup group;
+        std::unique_ptr<ElGamalEncrypter> encrypter;
+        std::unique_ptr<ElGamalDecrypter> decrypter;
+};
+
+/**
+ * the fused mask and partial decryption matches masking with Exp followed by
+ * PartialDecrypt, and still decrypts to the masked message
+ */
+TEST_F(ElGamalTest, MaskAndPartialDecryptMatchesExpThenPartialDecrypt) {
+    for (int i = 0; i < 10; i++) {
+        BigNum message = group.GeneratePrivateKey();
+        BigNum mask = encrypter->CreateRandomMask();
+        ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext ciphertext, encrypter->Encrypt(message));
+
+        ASSERT_OK_AND_ASSIGN(
+            elgamal::Ciphertext fused, decrypter->MaskAndPartialDecrypt(ciphertext, mask)
+        );
+        ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext masked, elgamal::Exp(ciphertext, mask));
+        ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext expected, decrypter->PartialDecrypt(masked));
+
+        EXPECT_EQ(fused.u, expected.u);
+        EXPECT_EQ(fused.e, expected.e);
+
+        // with a single key the partial decryption leaves g^(message * mask)
+        ASSERT_OK_AND_ASSIGN(ECPoint g, group.GetFixedGenerator());
+        ASSERT_OK_AND_ASSIGN(
+            ECPoint plaintext, g.Mul(message.ModMul(mask, group.GetOrder()))
+        );
+        EXPECT_EQ(fused.e, plaintext);
+    }
+}
+
+/**
+ * encryptions of zero are recognized, also after rerandomization, and anything
+ * else is not
+ */
+TEST_F(ElGamalTest, IsEncryptionOfZero) {
+    for (int i = 0; i < 20; i++) {
+        bool zero = i % 2 == 0;
+        BigNum message = zero ? ctx.Zero() : ctx.CreateBigNum(i);
+        ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext ciphertext, encrypter->Encrypt(message));
+        if (i % 4 < 2) {
+            ASSERT_OK_AND_ASSIGN(ciphertext, encrypter->ReRandomize(ciphertext));
+        }
+
+        EXPECT_THAT(decrypter->IsEncryptionOfZero(ciphertext), IsOkAndHolds(zero));
+    }
+
+    // (y - x) for equal and different x, as the protocols compute it
+    ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext x, encrypter->Encrypt(ctx.CreateBigNum(7)));
+    ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext y, encrypter->Encrypt(ctx.CreateBigNum(7)));
+    ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext z, encrypter->Encrypt(ctx.CreateBigNum(8)));
+    ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext minus_x, elgamal::Invert(x));
+    ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext y_minus_x, elgamal::Mul(y, minus_x));
+    ASSERT_OK_AND_ASSIGN(elgamal::Ciphertext z_minus_x, elgamal::Mul(z, minus_x));
+    EXPECT_THAT(decrypter->IsEncryptionOfZero(y_minus_x), IsOkAndHolds(true));
+    EXPECT_THAT(decrypter->IsEncryptionOfZero(z_minus_x), IsOkAndHolds(false));
+}
+
+}  // namespace
+}  // namespace upsi
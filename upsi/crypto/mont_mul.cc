@@ -66,7 +66,7 @@ MontBigNum& MontBigNum::MulInPlace(const MontBigNum& mont_big_num) {
   CHECK_EQ(mont_big_num.mont_ctx_, mont_ctx_);
   CRYPTO_CHECK(1 == BN_mod_mul_montgomery(bn_.get(), bn_.get(),
                                           mont_big_num.bn_.get(), mont_ctx_,
-                                          ctx_->GetBnCtx()));
+                                          ContextPool::GetBnCtx()));
   return *this;
 }
 
@@ -81,7 +81,7 @@ MontBigNum MontBigNum::PowTo2To(int64_t exponent) const {
   for (int64_t i = 0; i < exponent; i++) {
     CRYPTO_CHECK(1 == BN_mod_mul_montgomery(r.bn_.get(), r.bn_.get(),
                                             r.bn_.get(), mont_ctx_,
-                                            ctx_->GetBnCtx()));
+                                            ContextPool::GetBnCtx()));
   }
   return r;
 }
@@ -99,7 +99,7 @@ BigNum MontBigNum::ToBigNum() const {
   CHECK_NE(temp, nullptr);
   auto bn_ptr = BigNum::BignumPtr(temp);
   CRYPTO_CHECK(1 == BN_from_montgomery(bn_ptr.get(), bn_.get(), mont_ctx_,
-                                       ctx_->GetBnCtx()));
+                                       ContextPool::GetBnCtx()));
   return ctx_->CreateBigNum(std::move(bn_ptr));
 }
 
@@ -112,7 +112,7 @@ MontBigNum MontContext::CreateMontBigNum(const BigNum& big_num) {
   BIGNUM* bn = BN_dup(big_num.GetConstBignumPtr());
   CHECK_NE(bn, nullptr);
   CRYPTO_CHECK(1 ==
-               BN_to_montgomery(bn, bn, mont_ctx_.get(), ctx_->GetBnCtx()));
+               BN_to_montgomery(bn, bn, mont_ctx_.get(), ContextPool::GetBnCtx()));
   return MontBigNum(ctx_, mont_ctx_.get(), BigNum::BignumPtr(bn));
 }
 
@@ -120,11 +120,24 @@ MontBigNum MontContext::CreateMontBigNum(absl::string_view bytes) {
   return MontBigNum(ctx_, mont_ctx_.get(), bytes);
 }
 
+BigNum MontContext::ModExp(const BigNum& base, const BigNum& exponent) const {
+  CHECK(exponent.IsNonNegative())
+      << "MontContext::ModExp: exponent must be nonnegative";
+  BIGNUM* temp = BN_new();
+  CHECK_NE(temp, nullptr);
+  auto bn_ptr = BigNum::BignumPtr(temp);
+  CRYPTO_CHECK(1 == BN_mod_exp_mont(bn_ptr.get(), base.GetConstBignumPtr(),
+                                    exponent.GetConstBignumPtr(),
+                                    modulus_.GetConstBignumPtr(),
+                                    ContextPool::GetBnCtx(), mont_ctx_.get()));
+  return ctx_->CreateBigNum(std::move(bn_ptr));
+}
+
 MontContext::MontContext(Context* ctx, const BigNum& modulus)
     : modulus_(modulus), ctx_(ctx), mont_ctx_(MontCtxPtr(BN_MONT_CTX_new())) {
   CRYPTO_CHECK(1 == BN_MONT_CTX_set(mont_ctx_.get(),
                                     modulus.GetConstBignumPtr(),
-                                    ctx_->GetBnCtx()));
+                                    ContextPool::GetBnCtx()));
 }
 
 }  // namespace upsi
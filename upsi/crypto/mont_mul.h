@@ -127,6 +127,11 @@ class MontContext {
   // current MontContext, as long as their moduli are equal.
   MontBigNum CreateMontBigNum(absl::string_view bytes);
 
+  // Computes base^exponent mod modulus. Unlike BigNum::ModExp, which sets up
+  // a new BN_MONT_CTX on every call, this reuses the one of this context.
+  // Fails if exponent is negative.
+  BigNum ModExp(const BigNum& base, const BigNum& exponent) const;
+
   // Creates MontContext based on the given modulus. Every operation on the
   // created MontBigNums using this MontContext will be done with this modulus.
   MontContext(Context* ctx, const BigNum& modulus);
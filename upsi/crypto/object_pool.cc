@@ -0,0 +1,175 @@
+#include "upsi/crypto/object_pool.h"
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+
+namespace upsi {
+
+namespace {
+
+std::atomic<bool> pool_enabled{true};
+
+// Cached points of one named curve.
+struct PointList {
+  int curve_name;
+  std::vector<EC_POINT*> points;
+};
+
+class FreeLists {
+ public:
+  FreeLists() = default;
+  FreeLists(const FreeLists&) = delete;
+  FreeLists& operator=(const FreeLists&) = delete;
+
+  ~FreeLists() { Clear(); }
+
+  void Clear() {
+    for (BIGNUM* bn : bignums_) {
+      BN_free(bn);
+    }
+    bignums_.clear();
+    for (PointList& list : points_) {
+      for (EC_POINT* point : list.points) {
+        EC_POINT_free(point);
+      }
+    }
+    points_.clear();
+  }
+
+  size_t Size() const {
+    size_t size = bignums_.size();
+    for (const PointList& list : points_) {
+      size += list.points.size();
+    }
+    return size;
+  }
+
+  std::vector<BIGNUM*>& bignums() { return bignums_; }
+
+  // Returns the list for curve_name, creating it if needed.
+  std::vector<EC_POINT*>& points(int curve_name) {
+    for (PointList& list : points_) {
+      if (list.curve_name == curve_name) {
+        return list.points;
+      }
+    }
+    points_.push_back(PointList{curve_name, {}});
+    return points_.back().points;
+  }
+
+ private:
+  std::vector<BIGNUM*> bignums_;
+  // There are only ever a handful of curves, so a linear scan is enough.
+  std::vector<PointList> points_;
+};
+
+// Set once the calling thread's lists have been destroyed. BigNums with static
+// or thread storage duration can outlive them and must then be freed directly.
+thread_local bool lists_destroyed = false;
+
+class ThreadLists {
+ public:
+  ~ThreadLists() { lists_destroyed = true; }
+  FreeLists lists;
+};
+
+// Returns the calling thread's lists, or nullptr during thread teardown.
+FreeLists* GetLists() {
+  if (lists_destroyed) {
+    return nullptr;
+  }
+  thread_local ThreadLists thread_lists;
+  return &thread_lists.lists;
+}
+
+// Only plain heap BIGNUMs are recycled: flags such as BN_FLG_CONSTTIME would
+// otherwise carry over to the next user.
+bool IsRecyclable(const BIGNUM* bn) {
+  return BN_get_flags(bn, ~0) == BN_FLG_MALLOCED;
+}
+
+}  // namespace
+
+BIGNUM* ObjectPool::NewBignum() {
+  FreeLists* lists = GetLists();
+  if (lists != nullptr && !lists->bignums().empty()) {
+    BIGNUM* bn = lists->bignums().back();
+    lists->bignums().pop_back();
+    return bn;
+  }
+  BIGNUM* bn = BN_new();
+  CHECK_NE(bn, nullptr);
+  return bn;
+}
+
+void ObjectPool::FreeBignum(BIGNUM* bn) {
+  if (bn == nullptr) {
+    return;
+  }
+  FreeLists* lists = GetLists();
+  if (lists == nullptr || !IsEnabled() || !IsRecyclable(bn) ||
+      lists->bignums().size() >= kMaxCached) {
+    BN_clear_free(bn);
+    return;
+  }
+  BN_clear(bn);
+  lists->bignums().push_back(bn);
+}
+
+EC_POINT* ObjectPool::NewPoint(const EC_GROUP* group) {
+  int curve_name = EC_GROUP_get_curve_name(group);
+  FreeLists* lists = GetLists();
+  if (lists != nullptr && curve_name != NID_undef) {
+    std::vector<EC_POINT*>& points = lists->points(curve_name);
+    if (!points.empty()) {
+      EC_POINT* point = points.back();
+      points.pop_back();
+      return point;
+    }
+  }
+  return EC_POINT_new(group);
+}
+
+void ObjectPool::FreePoint(const EC_GROUP* group, EC_POINT* point) {
+  if (point == nullptr) {
+    return;
+  }
+  int curve_name = EC_GROUP_get_curve_name(group);
+  FreeLists* lists = GetLists();
+  if (lists == nullptr || !IsEnabled() || curve_name == NID_undef) {
+    EC_POINT_clear_free(point);
+    return;
+  }
+  std::vector<EC_POINT*>& points = lists->points(curve_name);
+  if (points.size() >= kMaxCached ||
+      1 != EC_POINT_set_to_infinity(group, point)) {
+    EC_POINT_clear_free(point);
+    return;
+  }
+  points.push_back(point);
+}
+
+void ObjectPool::Release() {
+  FreeLists* lists = GetLists();
+  if (lists != nullptr) {
+    lists->Clear();
+  }
+}
+
+size_t ObjectPool::NumCached() {
+  FreeLists* lists = GetLists();
+  return lists == nullptr ? 0 : lists->Size();
+}
+
+void ObjectPool::SetEnabled(bool enabled) {
+  pool_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool ObjectPool::IsEnabled() {
+  return pool_enabled.load(std::memory_order_relaxed);
+}
+
+}  // namespace upsi
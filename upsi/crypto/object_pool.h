@@ -0,0 +1,60 @@
+#ifndef upsi_CRYPTO_OBJECT_POOL_H_
+#define upsi_CRYPTO_OBJECT_POOL_H_
+
+#include <stddef.h>
+
+#include "upsi/crypto/openssl.inc"
+
+namespace upsi {
+
+// Per-thread free lists of BIGNUMs and EC_POINTs.
+//
+// BigNum and ECPoint results are short-lived: a candidate loop creates and
+// destroys several of them per Mul, Add, Clone or Inverse. Instead of handing
+// each one back to malloc, BigNum and ECPoint return their storage here when
+// they are destroyed and take it back on construction. A recycled BIGNUM also
+// keeps its word array, so the next result of the same size is not
+// reallocated either.
+//
+// Recycled BIGNUMs are cleared and recycled EC_POINTs are set to the point at
+// infinity, which is what BN_new and EC_POINT_new return. Points are kept per
+// named curve; points on custom curves are never cached.
+//
+// All methods act on the calling thread's lists only, so no locking is done.
+// A thread's lists are freed when it exits or when it calls Release.
+class ObjectPool {
+ public:
+  // Maximum number of objects cached in each of a thread's free lists.
+  // Anything released past this is freed immediately.
+  static constexpr size_t kMaxCached = 4096;
+
+  // Returns a zero BIGNUM, recycled if one is cached.
+  static BIGNUM* NewBignum();
+
+  // Clears bn and caches it for reuse, or frees it if pooling is disabled or
+  // the list is full.
+  static void FreeBignum(BIGNUM* bn);
+
+  // Returns a point at infinity on group, recycled if one is cached.
+  static EC_POINT* NewPoint(const EC_GROUP* group);
+
+  // Caches point, which must have been created on group, for reuse.
+  static void FreePoint(const EC_GROUP* group, EC_POINT* point);
+
+  // Frees every object cached by the calling thread. Called once a message
+  // has been handled so that the memory is not held between messages.
+  static void Release();
+
+  // Number of objects currently cached by the calling thread.
+  static size_t NumCached();
+
+  // Turns pooling on or off for every thread (it is on by default). While it
+  // is off objects are allocated and freed directly; already cached objects
+  // are still handed out.
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled();
+};
+
+}  // namespace upsi
+
+#endif  // upsi_CRYPTO_OBJECT_POOL_H_
@@ -0,0 +1,73 @@
+#include "upsi/crypto/object_pool.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "upsi/crypto/context.h"
+#include "upsi/crypto/ec_group.h"
+#include "upsi/crypto/ec_point.h"
+#include "upsi/util/status_testing.inc"
+
+namespace upsi {
+namespace {
+
+/**
+ * recycled BigNums come back as zero and copies stay independent
+ */
+TEST(ObjectPoolTest, RecycledBigNumsAreZero) {
+    Context ctx;
+    ObjectPool::Release();
+
+    {
+        BigNum big = ctx.CreateBigNum(1).Lshift(1000);
+        BigNum copy = big;
+        EXPECT_EQ(copy, big);
+    }
+    EXPECT_GE(ObjectPool::NumCached(), 2u);
+
+    BigNum fresh = ctx.CreateBigNum(7);
+    EXPECT_EQ(fresh, ctx.CreateBigNum(7));
+    EXPECT_TRUE(BigNum(ctx.Zero()).IsZero());
+
+    ObjectPool::Release();
+    EXPECT_EQ(ObjectPool::NumCached(), 0u);
+}
+
+/**
+ * recycled points come back as the point at infinity and arithmetic on them
+ * matches arithmetic on freshly allocated points
+ */
+TEST(ObjectPoolTest, RecycledPointsAreInfinity) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(ECGroup group, ECGroup::Create(NID_X9_62_prime256v1, &ctx));
+    ASSERT_OK_AND_ASSIGN(ECPoint g, group.GetFixedGenerator());
+    BigNum k = group.GeneratePrivateKey();
+
+    ObjectPool::SetEnabled(false);
+    ASSERT_OK_AND_ASSIGN(ECPoint expected, g.Mul(k));
+    ObjectPool::SetEnabled(true);
+
+    ObjectPool::Release();
+    {
+        std::vector<ECPoint> points;
+        for (int i = 0; i < 10; i++) {
+            ASSERT_OK_AND_ASSIGN(ECPoint point, g.Mul(group.GeneratePrivateKey()));
+            points.push_back(std::move(point));
+        }
+    }
+    EXPECT_GE(ObjectPool::NumCached(), 10u);
+
+    ASSERT_OK_AND_ASSIGN(ECPoint infinity, group.GetPointAtInfinity());
+    EXPECT_TRUE(infinity.IsPointAtInfinity());
+    ASSERT_OK_AND_ASSIGN(ECPoint actual, g.Mul(k));
+    EXPECT_EQ(actual, expected);
+    ASSERT_OK_AND_ASSIGN(ECPoint sum, actual.Add(infinity));
+    EXPECT_EQ(sum, expected);
+
+    ObjectPool::Release();
+}
+
+}  // namespace
+}  // namespace upsi
@@ -0,0 +1,74 @@
+#include "upsi/crypto/packed_paillier_pair.h"
+
+#include <utility>
+
+#include "absl/log/check.h"
+
+namespace upsi {
+
+PackedPaillierPair::PackedPaillierPair(Context* ctx, const PublicPaillier* pk)
+    : ctx_(ctx),
+      pk_(pk),
+      n_(pk->n()),
+      n_to_s_(n_ * n_),
+      offset_(ctx->One().Lshift(kValueBits - 1)) {
+  CHECK_EQ(pk->s(), 2) << "PackedPaillierPair needs a key with s = 2";
+  CHECK_LT(kLowBits + 1, n_.BitLength())
+      << "PackedPaillierPair: n is too small for the payload slot";
+}
+
+StatusOr<BigNum> PackedPaillierPair::Encode(const BigNum& element,
+                                            const BigNum& payload) const {
+  if (!element.IsNonNegative() || element >= n_) {
+    return InvalidArgumentError(
+        "PackedPaillierPair::Encode() - Element not in [0, n).");
+  }
+  BigNum low = payload + offset_;
+  if (!low.IsNonNegative() || low.BitLength() > kValueBits) {
+    return InvalidArgumentError(
+        "PackedPaillierPair::Encode() - Payload does not fit in the slot.");
+  }
+  return low + element.Lshift(kLowBits);
+}
+
+std::pair<BigNum, BigNum> PackedPaillierPair::Decode(
+    const BigNum& plaintext) const {
+  BigNum element = plaintext.Rshift(kLowBits);
+  BigNum payload = plaintext.GetLastNBits(kLowBits) - offset_;
+  return std::make_pair(std::move(element), std::move(payload));
+}
+
+StatusOr<BigNum> PackedPaillierPair::Encrypt(const BigNum& element,
+                                             const BigNum& payload) const {
+  ASSIGN_OR_RETURN(BigNum plaintext, Encode(element, payload));
+  return pk_->Encrypt(plaintext);
+}
+
+StatusOr<BigNum> PackedPaillierPair::MaskedDifference(
+    const BigNum& ciphertext, const BigNum& x, const BigNum& alpha) const {
+  // The mask is below 2^(kLowBits - 1) and the payload slot below
+  // 2^kValueBits, so their sum never carries into the element part.
+  BigNum mask = ContextPool::Get()->GenerateRandLessThan(
+      ctx_->One().Lshift(kLowBits - 1));
+  BigNum shift = alpha.ModSub(x, n_);
+  ASSIGN_OR_RETURN(BigNum masked, pk_->Encrypt(mask + shift.Lshift(kLowBits)));
+  return pk_->Add(ciphertext, masked);
+}
+
+BigNum PackedPaillierPair::DecodeDifference(const BigNum& plaintext) const {
+  return plaintext.Rshift(kLowBits).Mod(n_);
+}
+
+StatusOr<BigNum> PackedPaillierPair::PayloadProduct(const BigNum& ciphertext,
+                                                    const BigNum& x,
+                                                    const BigNum& value) const {
+  // Removes value * (offset + 2^kLowBits * x) from value * plaintext. The
+  // correction is added without a randomizer, see the header.
+  BigNum correction = (offset_ + x.Lshift(kLowBits)).ModMul(value, n_to_s_);
+  ASSIGN_OR_RETURN(BigNum encrypted_correction,
+                   pk_->EncryptUsingGeneratorAndRand(
+                       correction.ModNegate(n_to_s_), ctx_->Zero()));
+  return pk_->Add(pk_->Multiply(ciphertext, value), encrypted_correction);
+}
+
+}  // namespace upsi
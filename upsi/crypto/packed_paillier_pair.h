@@ -0,0 +1,83 @@
+#ifndef upsi_CRYPTO_PACKED_PAILLIER_PAIR_H_
+#define upsi_CRYPTO_PACKED_PAILLIER_PAIR_H_
+
+#include <utility>
+
+#include "upsi/crypto/big_num.h"
+#include "upsi/crypto/context.h"
+#include "upsi/crypto/paillier.h"
+#include "upsi/util/status.inc"
+
+namespace upsi {
+
+// Encodes an (element, payload) pair as a single Damgaard-Jurik ciphertext
+// with s = 2 instead of two ciphertexts with s = 1.
+//
+// The plaintext, mod n^2, is
+//   (payload + 2^(kValueBits - 1)) + 2^kLowBits * element
+// where element < n and |payload| < 2^(kValueBits - 1). The low kLowBits bits
+// leave kStatBits bits of headroom above the payload so that it can be
+// statistically masked, and the element part has room for one addition mod n
+// without reaching n^2.
+//
+// The two homomorphic operations of the deletion CombinePathInitiator are
+// provided on the encoded ciphertext:
+//   MaskedDifference: an encryption from which the key holder recovers
+//                     (element - x + alpha) mod n, and nothing about the
+//                     payload.
+//   PayloadProduct:   an encryption of value * payload mod n^2 if element = x.
+class PackedPaillierPair {
+ public:
+  static constexpr int kValueBits = 64;
+  static constexpr int kStatBits = 40;
+  static constexpr int kLowBits = kValueBits + kStatBits + 1;
+
+  // pk must use s = 2. Ownership is not taken.
+  PackedPaillierPair(Context* ctx, const PublicPaillier* pk);
+
+  // PackedPaillierPair is neither copyable nor movable.
+  PackedPaillierPair(const PackedPaillierPair&) = delete;
+  PackedPaillierPair& operator=(const PackedPaillierPair&) = delete;
+
+  // Returns the plaintext encoding of (element, payload). The payload may be
+  // negative. Returns INVALID_ARGUMENT if either is out of range.
+  StatusOr<BigNum> Encode(const BigNum& element, const BigNum& payload) const;
+
+  // Inverse of Encode, for a plaintext produced by it.
+  std::pair<BigNum, BigNum> Decode(const BigNum& plaintext) const;
+
+  // Encrypts Encode(element, payload) under pk.
+  StatusOr<BigNum> Encrypt(const BigNum& element, const BigNum& payload) const;
+
+  // Returns an encryption of r + 2^kLowBits * (element + ((alpha - x) mod n))
+  // for a fresh mask r of kLowBits - 1 bits, where element is the one
+  // encoded in ciphertext. x and alpha must be smaller than n.
+  StatusOr<BigNum> MaskedDifference(const BigNum& ciphertext, const BigNum& x,
+                                    const BigNum& alpha) const;
+
+  // Recovers (element - x + alpha) mod n from a decrypted MaskedDifference.
+  BigNum DecodeDifference(const BigNum& plaintext) const;
+
+  // Returns an encryption of
+  //   value * payload + 2^kLowBits * value * (element - x)   mod n^2,
+  // which is value * payload when the encoded element equals x. value must
+  // be nonnegative; encode negative values mod n^2.
+  // The result is not rerandomized, which saves an encryption: like gc_z in
+  // the deletion protocol it must be added to a fresh encryption before it
+  // is sent to the key holder.
+  StatusOr<BigNum> PayloadProduct(const BigNum& ciphertext, const BigNum& x,
+                                  const BigNum& value) const;
+
+ private:
+  Context* const ctx_;
+  const PublicPaillier* const pk_;
+  const BigNum n_;
+  // n^2, the plaintext modulus.
+  const BigNum n_to_s_;
+  // 2^(kValueBits - 1), added to the payload so that it is nonnegative.
+  const BigNum offset_;
+};
+
+}  // namespace upsi
+
+#endif  // upsi_CRYPTO_PACKED_PAILLIER_PAIR_H_
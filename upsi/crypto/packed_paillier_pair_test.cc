@@ -0,0 +1,68 @@
+#include "upsi/crypto/packed_paillier_pair.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "upsi/crypto/context.h"
+#include "upsi/crypto/paillier.h"
+#include "upsi/util/status_testing.inc"
+
+namespace upsi {
+namespace {
+
+const int32_t modulus_length = 1024;
+
+/**
+ * encoding round trips for positive, negative and zero payloads, and
+ * payloads outside the slot are rejected
+ */
+TEST(PackedPaillierPairTest, EncodeDecode) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(auto keys, GeneratePaillierKeyPair(&ctx, modulus_length, 2));
+    PublicPaillier pk(&ctx, std::get<0>(keys));
+    PackedPaillierPair pair(&ctx, &pk);
+
+    BigNum element = ctx.GenerateRandLessThan(pk.n());
+    for (const BigNum& payload : {ctx.CreateBigNum(5), ctx.Zero() - ctx.CreateBigNum(7), ctx.Zero()}) {
+        ASSERT_OK_AND_ASSIGN(BigNum plaintext, pair.Encode(element, payload));
+        auto decoded = pair.Decode(plaintext);
+        EXPECT_EQ(decoded.first, element);
+        EXPECT_EQ(decoded.second, payload);
+    }
+
+    EXPECT_FALSE(pair.Encode(element, ctx.One().Lshift(PackedPaillierPair::kValueBits)).ok());
+    EXPECT_FALSE(pair.Encode(pk.n(), ctx.One()).ok());
+}
+
+/**
+ * the masked difference decodes to element - x + alpha, and the payload
+ * product is value * payload exactly when the element matches
+ */
+TEST(PackedPaillierPairTest, CombinePathOperations) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(auto keys, GeneratePaillierKeyPair(&ctx, modulus_length, 2));
+    PublicPaillier pk(&ctx, std::get<0>(keys));
+    PrivatePaillier sk(&ctx, std::get<1>(keys));
+    PackedPaillierPair pair(&ctx, &pk);
+    const BigNum& n = pk.n();
+    BigNum n_squared = n * n;
+
+    BigNum element = ctx.GenerateRandLessThan(n);
+    BigNum payload = ctx.Zero() - ctx.CreateBigNum(12345);
+    BigNum value = ctx.CreateBigNum(3);
+    ASSERT_OK_AND_ASSIGN(BigNum ciphertext, pair.Encrypt(element, payload));
+
+    for (const BigNum& x : {element, ctx.GenerateRandLessThan(n)}) {
+        BigNum alpha = ctx.GenerateRandLessThan(n);
+        ASSERT_OK_AND_ASSIGN(BigNum masked, pair.MaskedDifference(ciphertext, x, alpha));
+        ASSERT_OK_AND_ASSIGN(BigNum plaintext, sk.Decrypt(masked));
+        EXPECT_EQ(pair.DecodeDifference(plaintext), (element + alpha).ModSub(x, n));
+    }
+
+    ASSERT_OK_AND_ASSIGN(BigNum product, pair.PayloadProduct(ciphertext, element, value));
+    ASSERT_OK_AND_ASSIGN(BigNum decrypted, sk.Decrypt(product));
+    EXPECT_EQ(decrypted, (payload * value).Mod(n_squared));
+}
+
+}  // namespace
+}  // namespace upsi
@@ -17,7 +17,12 @@
 
 #include <stddef.h>
 
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -27,7 +32,9 @@
 #include "upsi/crypto/big_num.h"
 #include "upsi/crypto/context.h"
 #include "upsi/crypto/fixed_base_exp.h"
+#include "upsi/crypto/safe_prime.h"
 #include "upsi/crypto/two_modulus_crt.h"
+#include "upsi/util/parallel.h"
 #include "upsi/util/status.inc"
 
 namespace upsi {
@@ -193,16 +200,21 @@ BigNum ComputeByBinomialExpansion(Context* ctx,
 }  // namespace
 
 StatusOr<std::pair<PaillierPublicKey, PaillierPrivateKey>>
-GeneratePaillierKeyPair(Context* ctx, int32_t modulus_length, int32_t s) {
+GeneratePaillierKeyPair(Context* /*ctx*/, int32_t modulus_length, int32_t s) {
   if (modulus_length / 2 <= 0 || s <= 0) {
     return InvalidArgumentError(
         "GeneratePaillierKeyPair: modulus_length/2 and s must each be >0");
   }
 
-  BigNum p = ctx->GenerateSafePrime(modulus_length / 2);
-  BigNum q = ctx->GenerateSafePrime(modulus_length / 2);
-  while (p == q) {
-    q = ctx->GenerateSafePrime(modulus_length / 2);
+  std::vector<BigNum> primes = GenerateSafePrimes(modulus_length / 2, 2);
+  return GeneratePaillierKeyPair(primes[0], primes[1], s);
+}
+
+StatusOr<std::pair<PaillierPublicKey, PaillierPrivateKey>>
+GeneratePaillierKeyPair(const BigNum& p, const BigNum& q, int32_t s) {
+  if (p == q || s <= 0) {
+    return InvalidArgumentError(
+        "GeneratePaillierKeyPair: p and q must differ and s must be >0");
   }
   BigNum n = p * q;
 
@@ -224,7 +236,8 @@ GeneratePaillierKeyPair(Context* ctx, int32_t modulus_length, int32_t s) {
 // randomness as computing (1+n)^m * random^(n^s) mod n^(s+1) whereas the former
 // is much faster as the modulus length is half the size of n for each step.
 //
-// This class is not thread-safe since Context is not thread-safe.
+// Its const methods may run on several threads at once, since their scratch
+// space comes from ContextPool.
 // Note that this does *not* take the ownership of Context.
 class PrimeCrypto {
  public:
@@ -252,7 +265,8 @@ class PrimeCrypto {
 
   // Computes (1+n)^m * g^r mod p^(s+1) where r is in [1, p).
   StatusOr<BigNum> Encrypt(const BigNum& m) const {
-    return EncryptWithRand(m, ctx_->GenerateRandBetween(ctx_->One(), p_));
+    return EncryptWithRand(
+        m, ContextPool::Get()->GenerateRandBetween(ctx_->One(), p_));
   }
 
   // Encrypts the message similar to other Encrypt method, but uses the input
@@ -340,7 +354,8 @@ class PrimeCryptoWithRand {
   // Encrypts the message the same way as in PrimeCrypto, and returns the
   // random used.
   StatusOr<PaillierEncAndRand> EncryptAndGetRand(const BigNum& m) const {
-    BigNum r = ctx_->GenerateRandBetween(ctx_->One(), prime_crypto_->p_);
+    BigNum r = ContextPool::Get()->GenerateRandBetween(ctx_->One(),
+                                                       prime_crypto_->p_);
     ASSIGN_OR_RETURN(BigNum ct, EncryptWithRand(m, r));
     ASSIGN_OR_RETURN(BigNum exp_for_report_to_r, exp_for_report_->ModExp(r));
     return {{std::move(ct), std::move(exp_for_report_to_r)}};
@@ -355,6 +370,103 @@ class PrimeCryptoWithRand {
   std::unique_ptr<FixedBaseExp> exp_for_report_;
 };
 
+// Holds precomputed randomizers, optionally refilled by a background thread.
+class PaillierRandomnessPool {
+ public:
+  // generate returns a fresh randomizer; it is called from worker threads.
+  explicit PaillierRandomnessPool(std::function<StatusOr<BigNum>()> generate)
+      : generate_(std::move(generate)) {}
+
+  PaillierRandomnessPool(const PaillierRandomnessPool&) = delete;
+  PaillierRandomnessPool& operator=(const PaillierRandomnessPool&) = delete;
+
+  ~PaillierRandomnessPool() {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    if (background_.joinable()) {
+      background_.join();
+    }
+  }
+
+  // Adds count randomizers, computed across worker threads.
+  Status Fill(size_t count) {
+    std::vector<BigNum> values(count, ContextPool::Get()->Zero());
+    RETURN_IF_ERROR(
+        ParallelFor(count, 1, [&](size_t begin, size_t end) -> Status {
+          for (size_t i = begin; i < end; i++) {
+            ASSIGN_OR_RETURN(values[i], generate_());
+          }
+          return OkStatus();
+        }));
+    std::lock_guard<std::mutex> lock(mu_);
+    for (BigNum& value : values) {
+      values_.push_back(std::move(value));
+    }
+    return OkStatus();
+  }
+
+  void StartBackground(size_t capacity) {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      capacity_ = capacity;
+      if (!background_.joinable()) {
+        background_ = std::thread([this]() { Run(); });
+      }
+    }
+    cv_.notify_all();
+  }
+
+  // Takes a randomizer out of the pool, if there is one.
+  std::optional<BigNum> Take() {
+    std::unique_lock<std::mutex> lock(mu_);
+    if (values_.empty()) {
+      return std::nullopt;
+    }
+    BigNum value = std::move(values_.back());
+    values_.pop_back();
+    lock.unlock();
+    cv_.notify_all();
+    return value;
+  }
+
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return values_.size();
+  }
+
+ private:
+  // Body of the background thread: tops the pool up to capacity_ and sleeps
+  // while it is full.
+  void Run() {
+    std::unique_lock<std::mutex> lock(mu_);
+    while (!stop_) {
+      if (values_.size() >= capacity_) {
+        cv_.wait(lock);
+        continue;
+      }
+      lock.unlock();
+      StatusOr<BigNum> value = generate_();
+      lock.lock();
+      if (!value.ok()) {
+        LOG(ERROR) << "PaillierRandomnessPool: " << value.status();
+        return;
+      }
+      values_.push_back(std::move(value).value());
+    }
+  }
+
+  const std::function<StatusOr<BigNum>()> generate_;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::vector<BigNum> values_;
+  size_t capacity_ = 0;
+  bool stop_ = false;
+  std::thread background_;
+};
+
 static const int kDefaultS = 1;
 
 PublicPaillier::PublicPaillier(Context* ctx, const BigNum& n, int s)
@@ -363,11 +475,15 @@ PublicPaillier::PublicPaillier(Context* ctx, const BigNum& n, int s)
       s_(s),
       n_powers_(GetPowers(ctx, n_, s)),
       modulus_(n_powers_.back()),
+      mont_ctx_(new MontContext(ctx, modulus_)),
       g_n_fbe_(FixedBaseExp::GetFixedBaseExp(
           ctx,
           GetGeneratorForSafeModulus(ctx_, n).ModExp(n_powers_[s], modulus_),
           modulus_)),
-      precomp_(GetPrecomp(ctx, n_, modulus_, s)) {}
+      precomp_(GetPrecomp(ctx, n_, modulus_, s)),
+      randomness_(new PaillierRandomnessPool([this]() {
+        return g_n_fbe_->ModExp(ContextPool::Get()->GenerateRandLessThan(n_));
+      })) {}
 
 PublicPaillier::PublicPaillier(Context* ctx, const BigNum& n)
     : PublicPaillier(ctx, n, kDefaultS) {}
@@ -385,7 +501,7 @@ BigNum PublicPaillier::Add(const BigNum& ciphertext1,
 }
 
 BigNum PublicPaillier::Multiply(const BigNum& c, const BigNum& m) const {
-  return c.ModExp(m, modulus_);
+  return mont_ctx_->ModExp(c, m);
 }
 
 BigNum PublicPaillier::LeftShift(const BigNum& c, int shift_amount) const {
@@ -401,7 +517,9 @@ StatusOr<BigNum> PublicPaillier::Encrypt(const BigNum& m) const {
     return InvalidArgumentError(
         "PublicPaillier::Encrypt() - Message not smaller than n^s.");
   }
-  return EncryptUsingGeneratorAndRand(m, ctx_->GenerateRandLessThan(n_));
+  BigNum c = ComputeByBinomialExpansion(ctx_, precomp_, n_powers_, m);
+  ASSIGN_OR_RETURN(BigNum g_n_to_r, NextRandomizer());
+  return c.ModMul(g_n_to_r, modulus_);
 }
 
 StatusOr<BigNum> PublicPaillier::EncryptUsingGeneratorAndRand(
@@ -415,6 +533,26 @@ StatusOr<BigNum> PublicPaillier::EncryptUsingGeneratorAndRand(
   return c.ModMul(g_n_to_r, modulus_);
 }
 
+StatusOr<BigNum> PublicPaillier::NextRandomizer() const {
+  std::optional<BigNum> precomputed = randomness_->Take();
+  if (precomputed.has_value()) {
+    return std::move(*precomputed);
+  }
+  return g_n_fbe_->ModExp(ContextPool::Get()->GenerateRandLessThan(n_));
+}
+
+Status PublicPaillier::PrecomputeRandomness(size_t count) {
+  return randomness_->Fill(count);
+}
+
+void PublicPaillier::StartBackgroundRandomness(size_t capacity) {
+  randomness_->StartBackground(capacity);
+}
+
+size_t PublicPaillier::NumPrecomputedRandomness() const {
+  return randomness_->Size();
+}
+
 StatusOr<BigNum> PublicPaillier::EncryptWithRand(const BigNum& m,
                                                  const BigNum& r) const {
   if (r.Gcd(n_) != ctx_->One()) {
@@ -427,17 +565,32 @@ StatusOr<BigNum> PublicPaillier::EncryptWithRand(const BigNum& m,
 
 StatusOr<PaillierEncAndRand> PublicPaillier::EncryptAndGetRand(
     const BigNum& m) const {
-  BigNum r = ctx_->RelativelyPrimeRandomLessThan(n_);
+  BigNum r = ContextPool::Get()->RelativelyPrimeRandomLessThan(n_);
   ASSIGN_OR_RETURN(BigNum c, EncryptWithRand(m, r));
   return {{std::move(c), std::move(r)}};
 }
 
 StatusOr<BigNum> PublicPaillier::ReRand(const BigNum& c) const {
-  BigNum r = ctx_->GenerateRandLessThan(n_);
-  ASSIGN_OR_RETURN(BigNum g_n_to_r, g_n_fbe_->ModExp(r));
+  ASSIGN_OR_RETURN(BigNum g_n_to_r, NextRandomizer());
   return c.ModMul(g_n_to_r, modulus_);
 }
 
+MontBigNum PublicPaillier::ToMont(const BigNum& c) const {
+  if (c >= modulus_) {
+    return mont_ctx_->CreateMontBigNum(c.Mod(modulus_));
+  }
+  return mont_ctx_->CreateMontBigNum(c);
+}
+
+BigNum PublicPaillier::FromMont(const MontBigNum& c) const {
+  return c.ToBigNum();
+}
+
+MontBigNum PublicPaillier::AddMont(const MontBigNum& c1,
+                                   const MontBigNum& c2) const {
+  return c1.Mul(c2);
+}
+
 PrivatePaillier::~PrivatePaillier() = default;
 
 PrivatePaillier::PrivatePaillier(Context* ctx, const BigNum& p, const BigNum& q,
@@ -488,6 +641,40 @@ StatusOr<BigNum> PrivatePaillier::Decrypt(const BigNum& c) const {
                                        q_crypto_->Decrypt(c));
 }
 
+StatusOr<std::vector<BigNum>> PrivatePaillier::DecryptBatch(
+    const std::vector<BigNum>& cs) const {
+  for (const BigNum& c : cs) {
+    if (!c.IsNonNegative()) {
+      return InvalidArgumentError(
+          "PrivatePaillier::DecryptBatch() - Cannot decrypt negative number.");
+    }
+    if (c >= n_to_s_plus_one_) {
+      return InvalidArgumentError(
+          "PrivatePaillier::DecryptBatch() - Ciphertext not smaller than "
+          "n^(s+1).");
+    }
+  }
+  // Index i < size is the p half of cs[i] and index size + i its q half, so
+  // that even a single ciphertext keeps two threads busy.
+  const size_t size = cs.size();
+  std::vector<BigNum> halves(2 * size, ctx_->Zero());
+  RETURN_IF_ERROR(
+      ParallelFor(2 * size, 1, [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+          halves[i] = i < size ? p_crypto_->Decrypt(cs[i])
+                               : q_crypto_->Decrypt(cs[i - size]);
+        }
+        return OkStatus();
+      }));
+  std::vector<BigNum> messages;
+  messages.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    messages.push_back(
+        two_mod_crt_decrypt_->Compute(halves[i], halves[size + i]));
+  }
+  return messages;
+}
+
 PrivatePaillierWithRand::PrivatePaillierWithRand(
     PrivatePaillier* private_paillier)
     : ctx_(private_paillier->ctx_), private_paillier_(private_paillier) {
@@ -61,6 +61,7 @@
 
 #include "upsi/crypto/big_num.h"
 #include "upsi/crypto/context.h"
+#include "upsi/crypto/mont_mul.h"
 #include "upsi/crypto/paillier.pb.h"
 #include "upsi/util/status.inc"
 
@@ -75,6 +76,8 @@ class PrimeCryptoWithRand;
 
 class FixedBaseExp;
 class TwoModulusCrt;
+// A thread-safe store of precomputed encryption randomizers.
+class PaillierRandomnessPool;
 
 // Holds the resulting ciphertext from a Paillier encryption as well as the
 // random number used.
@@ -86,10 +89,16 @@ struct PaillierEncAndRand {
 // Returns a Paillier public key and private key. The Paillier modulus n will be
 // generated to be the product of safe primes p and q, each of modulus_length/2
 // bits. "s" is the Damgard-Jurik parameter: the corresponding message space is
-// n^s, and the ciphertext space is n^(s+1).
+// n^s, and the ciphertext space is n^(s+1). The primes are drawn from the
+// calling thread's ContextPool context; ctx is kept for existing callers.
 StatusOr<std::pair<PaillierPublicKey, PaillierPrivateKey>>
 GeneratePaillierKeyPair(Context* ctx, int32_t modulus_length, int32_t s);
 
+// Returns the Paillier public key and private key with modulus n = p * q, for
+// safe primes p and q obtained elsewhere (e.g. from a SafePrimeCache).
+StatusOr<std::pair<PaillierPublicKey, PaillierPrivateKey>>
+GeneratePaillierKeyPair(const BigNum& p, const BigNum& q, int32_t s);
+
 // The class defining Damgaard-Jurik cryptosystem operations that can be
 // performed with the public key.
 // Example:
@@ -99,7 +108,12 @@ GeneratePaillierKeyPair(Context* ctx, int32_t modulus_length, int32_t s);
 //       new PublicPaillier(ctx.get(), n, 2));
 //   BigNum ciphertext = public_paillier->Encrypt(message);
 //
-// This class is not thread-safe since Context is not thread-safe.
+// Once constructed, a PublicPaillier may be shared by worker threads: the
+// arithmetic draws its scratch space from the calling thread's ContextPool
+// context, and ctx is only used to set up the key and to create BigNums. The
+// randomizer pool filled by PrecomputeRandomness and
+// StartBackgroundRandomness is guarded by its own mutex, so it may be
+// drained and refilled concurrently.
 // Note that this class does *not* take the ownership of Context.
 class PublicPaillier {
  friend class ThresholdPaillier;
@@ -170,12 +184,36 @@ class PublicPaillier {
 
   StatusOr<BigNum> ReRand(const BigNum& ciphertext) const;
 
+  // Montgomery-form addition for long chains of homomorphic additions (see
+  // PaillierPacking): the operands are converted into Montgomery form mod
+  // n^(s+1) once, every addition is then a single Montgomery multiplication,
+  // and the result is converted back with FromMont.
+  MontBigNum ToMont(const BigNum& ciphertext) const;
+  BigNum FromMont(const MontBigNum& ciphertext) const;
+  MontBigNum AddMont(const MontBigNum& ciphertext1,
+                     const MontBigNum& ciphertext2) const;
+
+  // Precomputes count randomizers g^r mod n^(s+1), spread over worker
+  // threads. Encrypt and ReRand take one each, which turns their fixed-base
+  // exponentiation into a single modular multiplication; once the pool is
+  // empty they compute the randomizer online again.
+  Status PrecomputeRandomness(size_t count);
+
+  // Starts a background thread that keeps up to capacity randomizers ready,
+  // refilling the pool as Encrypt and ReRand drain it. The thread is stopped
+  // when this PublicPaillier is destroyed. Calling it again only changes the
+  // capacity.
+  void StartBackgroundRandomness(size_t capacity);
+
+  // Returns the number of precomputed randomizers currently available.
+  size_t NumPrecomputedRandomness() const;
+
   const BigNum& n() const { return n_; }
   int s() const { return s_; }
 
  private:
-  // Factory class for creating BigNums and holding the temporary values for
-  // the BigNum arithmetic operations. Ownership is not taken.
+  // Factory class for creating BigNums; the temporary values of the BigNum
+  // arithmetic come from ContextPool. Ownership is not taken.
   Context* const ctx_;
   // Composite BigNum of two large primes.
   const BigNum n_;
@@ -184,6 +222,9 @@ class PublicPaillier {
   const std::vector<BigNum> n_powers_;
   // n^(s+1)
   const BigNum modulus_;
+  // Montgomery constants for modulus_, shared by Multiply and the *Mont
+  // operations.
+  std::unique_ptr<MontContext> mont_ctx_;
   // generator of the subgroup of n^s-th residues mod n^s+1. Used for faster
   // computation of the random component r of the ciphertext.
   std::unique_ptr<FixedBaseExp> g_n_fbe_;
@@ -195,6 +236,13 @@ class PublicPaillier {
   // Refer to Section 4.2 "Optimization of Encryption" from the
   // Damgaard-Jurik-Nielsen paper for more information.
   const std::vector<BigNum> precomp_;
+  // Precomputed g^r values. Declared last so that its background thread is
+  // stopped before g_n_fbe_ is destroyed.
+  std::unique_ptr<PaillierRandomnessPool> randomness_;
+
+  // Returns g^r mod n^(s+1) for a fresh random r, from the pool if it has
+  // one.
+  StatusOr<BigNum> NextRandomizer() const;
 };
 
 // The class defining Damgaard-Jurik cryptosystem operations that can be
@@ -210,7 +258,8 @@ class PublicPaillier {
 //   BigNum ciphertext = private_paillier->Encrypt(message);
 //   BigNum message_as_bignum = private_paillier->Decrypt(ciphertext);
 //
-// This class is not thread-safe since Context is not thread-safe.
+// Like PublicPaillier, a constructed PrivatePaillier may be shared by worker
+// threads; scratch space comes from ContextPool rather than from ctx.
 // Note that this class does *not* take the ownership of Context.
 class PrivatePaillier {
  public:
@@ -256,6 +305,13 @@ class PrivatePaillier {
   // Returns INVALID_ARGUMENT status when the ciphertext is < 0 or >= n^(s+1).
   StatusOr<BigNum> Decrypt(const BigNum& ciphertext) const;
 
+  // Decrypts every ciphertext like Decrypt does. The exponentiations mod
+  // p^(s+1) and q^(s+1) of all ciphertexts are spread over worker threads,
+  // and the two halves are then combined with the Chinese Remainder Theorem.
+  // Returns INVALID_ARGUMENT status if any ciphertext is out of range.
+  StatusOr<std::vector<BigNum>> DecryptBatch(
+      const std::vector<BigNum>& ciphertexts) const;
+
   const BigNum& n() const { return n_to_s_; }
 
  private:
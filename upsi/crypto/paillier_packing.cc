@@ -0,0 +1,113 @@
+#include "upsi/crypto/paillier_packing.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/log/check.h"
+#include "upsi/crypto/mont_mul.h"
+#include "upsi/util/parallel.h"
+
+namespace upsi {
+
+namespace {
+
+// Packed ciphertexts are independent, so each one is a task of its own.
+constexpr size_t kMinPackedChunk = 1;
+
+}  // namespace
+
+PaillierPacking::PaillierPacking(Context* ctx, const BigNum& n, int slot_bits)
+    : ctx_(ctx),
+      slot_bits_(slot_bits),
+      slots_(slot_bits > 0 ? (n.BitLength() - 1) / slot_bits : 0) {
+  CHECK_GT(slots_, 0u) << "PaillierPacking: a " << slot_bits
+                       << "-bit slot does not fit below n";
+}
+
+std::vector<BigNum> PaillierPacking::Pack(
+    const std::vector<BigNum>& values) const {
+  std::vector<BigNum> plaintexts;
+  plaintexts.reserve(NumPacked(values.size()));
+  for (size_t begin = 0; begin < values.size(); begin += slots_) {
+    size_t end = std::min(values.size(), begin + slots_);
+    BigNum plaintext = ctx_->Zero();
+    for (size_t j = end; j > begin; j--) {
+      plaintext = plaintext.Lshift(slot_bits_) + values[j - 1];
+    }
+    plaintexts.push_back(std::move(plaintext));
+  }
+  return plaintexts;
+}
+
+std::vector<BigNum> PaillierPacking::Unpack(
+    const std::vector<BigNum>& plaintexts, size_t count) const {
+  std::vector<BigNum> values;
+  values.reserve(count);
+  for (const BigNum& plaintext : plaintexts) {
+    for (size_t i = 0; i < slots_ && values.size() < count; i++) {
+      values.push_back(
+          plaintext.Rshift(i * slot_bits_).GetLastNBits(slot_bits_));
+    }
+  }
+  return values;
+}
+
+StatusOr<std::vector<BigNum>> PaillierPacking::EncryptPacked(
+    const PublicPaillier& pk, const std::vector<BigNum>& values) const {
+  std::vector<BigNum> plaintexts = Pack(values);
+  std::vector<BigNum> packed(plaintexts.size(), ctx_->Zero());
+  RETURN_IF_ERROR(ParallelFor(
+      plaintexts.size(), kMinPackedChunk,
+      [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+          ASSIGN_OR_RETURN(packed[i], pk.Encrypt(plaintexts[i]));
+        }
+        return OkStatus();
+      }));
+  return packed;
+}
+
+StatusOr<std::vector<BigNum>> PaillierPacking::AddPacked(
+    const PublicPaillier& pk, const std::vector<BigNum>& packed,
+    const std::vector<BigNum>& ciphertexts) const {
+  if (NumPacked(ciphertexts.size()) > packed.size()) {
+    return InvalidArgumentError(
+        "PaillierPacking::AddPacked() - More ciphertexts than packed slots.");
+  }
+  std::vector<BigNum> result(packed.size(), ctx_->Zero());
+  RETURN_IF_ERROR(ParallelFor(
+      packed.size(), kMinPackedChunk,
+      [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+          size_t first = std::min(ciphertexts.size(), i * slots_);
+          size_t last = std::min(ciphertexts.size(), first + slots_);
+          if (first == last) {
+            result[i] = packed[i];
+            continue;
+          }
+          // Horner: c_last^(2^w) * c_(last-1), squared w more times, and so
+          // on down to c_first, leaves every c_j shifted into its own slot.
+          MontBigNum acc = pk.ToMont(ciphertexts[last - 1]);
+          for (size_t j = last - 1; j > first; j--) {
+            acc = acc.PowTo2To(slot_bits_);
+            acc.MulInPlace(pk.ToMont(ciphertexts[j - 1]));
+          }
+          result[i] = pk.FromMont(pk.AddMont(acc, pk.ToMont(packed[i])));
+        }
+        return OkStatus();
+      }));
+  return result;
+}
+
+StatusOr<std::vector<BigNum>> PaillierPacking::DecryptPacked(
+    const PrivatePaillier& sk, const std::vector<BigNum>& packed,
+    size_t count) const {
+  if (count > packed.size() * slots_) {
+    return InvalidArgumentError(
+        "PaillierPacking::DecryptPacked() - Fewer packed slots than count.");
+  }
+  ASSIGN_OR_RETURN(std::vector<BigNum> plaintexts, sk.DecryptBatch(packed));
+  return Unpack(plaintexts, count);
+}
+
+}  // namespace upsi
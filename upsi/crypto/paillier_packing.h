@@ -0,0 +1,75 @@
+#ifndef upsi_CRYPTO_PAILLIER_PACKING_H_
+#define upsi_CRYPTO_PAILLIER_PACKING_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "upsi/crypto/big_num.h"
+#include "upsi/crypto/context.h"
+#include "upsi/crypto/paillier.h"
+#include "upsi/util/status.inc"
+
+namespace upsi {
+
+// Packs many small values into the slots of one Paillier plaintext.
+//
+// Slot i of a plaintext holds bits [i * slot_bits, (i + 1) * slot_bits). A
+// plaintext has (bits(n) - 1) / slot_bits slots, so that the packed value is
+// always smaller than n. Callers must keep every slot value below
+// 2^slot_bits, including after homomorphic additions, or the slots overflow
+// into each other.
+//
+// Values are packed into consecutive plaintexts: value j lands in slot
+// j % SlotsPerPlaintext() of plaintext j / SlotsPerPlaintext().
+class PaillierPacking {
+ public:
+  // Creates a packing for plaintexts mod n. CHECK-fails if not even one slot
+  // fits.
+  PaillierPacking(Context* ctx, const BigNum& n, int slot_bits);
+
+  // PaillierPacking is neither copyable nor movable.
+  PaillierPacking(const PaillierPacking&) = delete;
+  PaillierPacking& operator=(const PaillierPacking&) = delete;
+
+  int slot_bits() const { return slot_bits_; }
+  size_t SlotsPerPlaintext() const { return slots_; }
+
+  // Number of plaintexts needed for count values.
+  size_t NumPacked(size_t count) const { return (count + slots_ - 1) / slots_; }
+
+  // Packs the values into NumPacked(values.size()) plaintexts.
+  std::vector<BigNum> Pack(const std::vector<BigNum>& values) const;
+
+  // Splits the plaintexts back into their first count slot values.
+  std::vector<BigNum> Unpack(const std::vector<BigNum>& plaintexts,
+                             size_t count) const;
+
+  // Packs the values and encrypts every plaintext under pk.
+  StatusOr<std::vector<BigNum>> EncryptPacked(
+      const PublicPaillier& pk, const std::vector<BigNum>& values) const;
+
+  // Homomorphically adds the plaintext of ciphertexts[j] to slot j of the
+  // packed ciphertexts, which must hold at least ciphertexts.size() slots. A
+  // slot that should stay unchanged can be given the ciphertext 1. Each
+  // packed ciphertext is built with one Montgomery-form Horner pass, i.e.
+  // about bits(n) squarings, rather than one exponentiation per slot.
+  StatusOr<std::vector<BigNum>> AddPacked(
+      const PublicPaillier& pk, const std::vector<BigNum>& packed,
+      const std::vector<BigNum>& ciphertexts) const;
+
+  // Decrypts the packed ciphertexts with sk and returns their first count
+  // slot values.
+  StatusOr<std::vector<BigNum>> DecryptPacked(
+      const PrivatePaillier& sk, const std::vector<BigNum>& packed,
+      size_t count) const;
+
+ private:
+  Context* const ctx_;
+  const int slot_bits_;
+  const size_t slots_;
+};
+
+}  // namespace upsi
+
+#endif  // upsi_CRYPTO_PAILLIER_PACKING_H_
@@ -0,0 +1,79 @@
+#include "upsi/crypto/paillier_packing.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "upsi/crypto/context.h"
+#include "upsi/crypto/paillier.h"
+#include "upsi/util/status_testing.inc"
+
+namespace upsi {
+namespace {
+
+const int32_t modulus_length = 1024;
+const int32_t slot_bits      = 105;
+
+/**
+ * packing and unpacking returns the original values, including ones that
+ * fill a whole slot and a last plaintext that is only partly used
+ */
+TEST(PaillierPackingTest, PackUnpack) {
+    Context ctx;
+    BigNum n = ctx.GenerateSafePrime(modulus_length / 2) * ctx.GenerateSafePrime(modulus_length / 2);
+    PaillierPacking packing(&ctx, n, slot_bits);
+    EXPECT_EQ(packing.SlotsPerPlaintext(), (n.BitLength() - 1) / slot_bits);
+
+    BigNum bound = ctx.One().Lshift(slot_bits);
+    std::vector<BigNum> values = {ctx.Zero(), bound - ctx.One()};
+    for (int i = 0; i < 20; i++) {
+        values.push_back(ctx.GenerateRandLessThan(bound));
+    }
+
+    std::vector<BigNum> plaintexts = packing.Pack(values);
+    EXPECT_EQ(plaintexts.size(), packing.NumPacked(values.size()));
+    for (const BigNum& plaintext : plaintexts) {
+        EXPECT_TRUE(plaintext < n);
+    }
+    EXPECT_EQ(packing.Unpack(plaintexts, values.size()), values);
+}
+
+/**
+ * ciphertexts added into their slots decrypt to the slot value plus their
+ * plaintext, and slots given the ciphertext 1 stay unchanged
+ */
+TEST(PaillierPackingTest, EncryptAddDecrypt) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(auto keys, GeneratePaillierKeyPair(&ctx, modulus_length, 1));
+    PublicPaillier pk(&ctx, std::get<0>(keys));
+    PrivatePaillier sk(&ctx, std::get<1>(keys));
+    PaillierPacking packing(&ctx, pk.n(), slot_bits);
+
+    BigNum bound = ctx.One().Lshift(slot_bits - 1);
+    std::vector<BigNum> values, addends, ciphertexts;
+    for (int i = 0; i < 25; i++) {
+        values.push_back(ctx.GenerateRandLessThan(bound));
+        addends.push_back(i % 3 == 0 ? ctx.Zero() : ctx.GenerateRandLessThan(bound));
+        if (i % 3 == 0) {
+            ciphertexts.push_back(ctx.One());
+        } else {
+            ASSERT_OK_AND_ASSIGN(BigNum ciphertext, pk.Encrypt(addends.back()));
+            ciphertexts.push_back(ciphertext);
+        }
+    }
+
+    ASSERT_OK_AND_ASSIGN(std::vector<BigNum> packed, packing.EncryptPacked(pk, values));
+    ASSERT_OK_AND_ASSIGN(packed, packing.AddPacked(pk, packed, ciphertexts));
+    ASSERT_OK_AND_ASSIGN(
+        std::vector<BigNum> decrypted, packing.DecryptPacked(sk, packed, values.size())
+    );
+
+    ASSERT_EQ(decrypted.size(), values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(decrypted[i], values[i] + addends[i]);
+    }
+}
+
+}  // namespace
+}  // namespace upsi
@@ -0,0 +1,137 @@
+#include "upsi/crypto/safe_prime.h"
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "absl/log/check.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "upsi/crypto/context.h"
+#include "upsi/crypto/openssl.inc"
+#include "upsi/util/parallel.h"
+
+namespace upsi {
+
+namespace {
+
+class GencbDeleter {
+ public:
+  void operator()(BN_GENCB* cb) { BN_GENCB_free(cb); }
+};
+
+// Progress callback of BN_generate_prime_ex: returning 0 aborts the search.
+int ContinueSearch(int /*event*/, int /*n*/, BN_GENCB* cb) {
+  auto* done = static_cast<std::atomic<bool>*>(BN_GENCB_get_arg(cb));
+  return done->load(std::memory_order_relaxed) ? 0 : 1;
+}
+
+// Reads the primes of prime_length bits stored in path, in file order.
+StatusOr<std::vector<BigNum>> ReadCache(const std::string& path,
+                                        int prime_length) {
+  std::vector<BigNum> primes;
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    // A missing file is an empty cache.
+    return primes;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    int bits;
+    std::string hex;
+    if (!(fields >> bits >> hex)) {
+      continue;
+    }
+    if (bits != prime_length) {
+      continue;
+    }
+    BigNum prime =
+        ContextPool::Get()->CreateBigNum(absl::HexStringToBytes(hex));
+    if (prime.BitLength() != prime_length || !prime.IsSafePrime()) {
+      return InvalidArgumentError(
+          absl::StrCat("SafePrimeCache: bad entry in ", path));
+    }
+    primes.push_back(std::move(prime));
+  }
+  return primes;
+}
+
+}  // namespace
+
+std::vector<BigNum> GenerateSafePrimes(int prime_length, size_t count) {
+  std::mutex mu;
+  std::vector<BigNum> primes;
+  std::atomic<bool> done{count == 0};
+
+  auto search = [&]() {
+    std::unique_ptr<BN_GENCB, GencbDeleter> cb(BN_GENCB_new());
+    CHECK(cb != nullptr);
+    BN_GENCB_set(cb.get(), &ContinueSearch, &done);
+    while (!done.load(std::memory_order_relaxed)) {
+      BigNum::BignumPtr bn(BN_new());
+      CHECK(bn != nullptr);
+      if (1 != BN_generate_prime_ex(bn.get(), prime_length, 1, nullptr,
+                                    nullptr, cb.get())) {
+        CHECK(done.load()) << "GenerateSafePrimes: " << OpenSSLErrorString();
+        return;
+      }
+      BigNum prime = ContextPool::Get()->CreateBigNum(std::move(bn));
+      std::lock_guard<std::mutex> lock(mu);
+      if (primes.size() == count) {
+        return;
+      }
+      bool duplicate = false;
+      for (const BigNum& other : primes) {
+        duplicate |= other == prime;
+      }
+      if (!duplicate) {
+        primes.push_back(std::move(prime));
+      }
+      if (primes.size() == count) {
+        done = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < NumWorkers(); i++) {
+    workers.emplace_back(search);
+  }
+  search();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  return primes;
+}
+
+SafePrimeCache::SafePrimeCache(std::string path) : path_(std::move(path)) {}
+
+StatusOr<std::vector<BigNum>> SafePrimeCache::Take(int prime_length,
+                                                   size_t count) {
+  ASSIGN_OR_RETURN(std::vector<BigNum> cached, ReadCache(path_, prime_length));
+  size_t begin = taken_[prime_length];
+  size_t wanted = begin + count;
+  if (cached.size() < wanted) {
+    std::vector<BigNum> fresh =
+        GenerateSafePrimes(prime_length, wanted - cached.size());
+    std::ofstream out(path_, std::ios::app);
+    if (!out.is_open()) {
+      return InvalidArgumentError(
+          absl::StrCat("SafePrimeCache: cannot write ", path_));
+    }
+    for (BigNum& prime : fresh) {
+      out << prime_length << " " << absl::BytesToHexString(prime.ToBytes())
+          << "\n";
+      cached.push_back(std::move(prime));
+    }
+  }
+  taken_[prime_length] = wanted;
+  return std::vector<BigNum>(cached.begin() + begin, cached.begin() + wanted);
+}
+
+}  // namespace upsi
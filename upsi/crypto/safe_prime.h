@@ -0,0 +1,49 @@
+#ifndef upsi_CRYPTO_SAFE_PRIME_H_
+#define upsi_CRYPTO_SAFE_PRIME_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "upsi/crypto/big_num.h"
+#include "upsi/util/status.inc"
+
+namespace upsi {
+
+// Returns count distinct safe primes of prime_length bits.
+//
+// Generating a large safe prime is a long random search, so one search is run
+// on every core. Each prime found is kept, and once count primes have been
+// collected a shared flag makes the searches still running abort from
+// OpenSSL's progress callback instead of finishing their current candidate.
+std::vector<BigNum> GenerateSafePrimes(int prime_length, size_t count);
+
+// A file of pre-generated safe primes, for test environments that do not want
+// to wait for key generation on every setup. Never use it for real keys: the
+// same primes are handed out on every run.
+//
+// The file holds one prime per line as "<bit length> <hex>". Primes missing
+// from it are generated with GenerateSafePrimes and appended.
+class SafePrimeCache {
+ public:
+  explicit SafePrimeCache(std::string path);
+
+  // SafePrimeCache is neither copyable nor movable.
+  SafePrimeCache(const SafePrimeCache&) = delete;
+  SafePrimeCache& operator=(const SafePrimeCache&) = delete;
+
+  // Returns count safe primes of prime_length bits that this SafePrimeCache
+  // has not returned before.
+  StatusOr<std::vector<BigNum>> Take(int prime_length, size_t count);
+
+ private:
+  const std::string path_;
+  // Number of primes of each length already returned by Take.
+  std::map<int, size_t> taken_;
+};
+
+}  // namespace upsi
+
+#endif  // upsi_CRYPTO_SAFE_PRIME_H_
@@ -0,0 +1,61 @@
+#include "upsi/crypto/safe_prime.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "upsi/util/status_testing.inc"
+
+namespace upsi {
+namespace {
+
+const int prime_length = 256;
+
+/**
+ * the parallel search returns the requested number of distinct safe primes
+ */
+TEST(SafePrimeTest, GeneratesDistinctSafePrimes) {
+    std::vector<BigNum> primes = GenerateSafePrimes(prime_length, 4);
+    ASSERT_EQ(primes.size(), 4u);
+    for (size_t i = 0; i < primes.size(); i++) {
+        EXPECT_EQ(primes[i].BitLength(), prime_length);
+        EXPECT_TRUE(primes[i].IsSafePrime());
+        for (size_t j = 0; j < i; j++) {
+            EXPECT_NE(primes[i], primes[j]);
+        }
+    }
+    EXPECT_TRUE(GenerateSafePrimes(prime_length, 0).empty());
+}
+
+/**
+ * a cache hands out distinct primes within one run and the same primes again
+ * once it is reopened
+ */
+TEST(SafePrimeTest, CacheReusesPrimes) {
+    std::string path = ::testing::TempDir() + "/safe_prime_test.cache";
+    std::remove(path.c_str());
+
+    std::vector<BigNum> first;
+    {
+        SafePrimeCache cache(path);
+        ASSERT_OK_AND_ASSIGN(first, cache.Take(prime_length, 2));
+        ASSERT_OK_AND_ASSIGN(std::vector<BigNum> more, cache.Take(prime_length, 1));
+        ASSERT_EQ(first.size(), 2u);
+        ASSERT_EQ(more.size(), 1u);
+        EXPECT_NE(more[0], first[0]);
+        EXPECT_NE(more[0], first[1]);
+        first.push_back(more[0]);
+    }
+
+    SafePrimeCache reopened(path);
+    ASSERT_OK_AND_ASSIGN(std::vector<BigNum> again, reopened.Take(prime_length, 3));
+    EXPECT_EQ(again, first);
+
+    std::remove(path.c_str());
+}
+
+}  // namespace
+}  // namespace upsi
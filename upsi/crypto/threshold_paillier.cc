@@ -3,6 +3,8 @@
 #include "upsi/crypto/big_num.h"
 #include "upsi/crypto/context.h"
 #include "upsi/crypto/paillier.h"
+#include "upsi/crypto/safe_prime.h"
+#include "upsi/util/parallel.h"
 #include "upsi/util/proto_util.h"
 #include "upsi/util/status.inc"
 
@@ -15,9 +17,23 @@ StatusOr<
         int32_t modulus_length,
         int32_t statistical_param
     ) {
-        // factorization of our modulus
-        BigNum p = ctx->GenerateSafePrime(modulus_length / 2);
-        BigNum q = ctx->GenerateSafePrime(modulus_length / 2);
+        // factorization of our modulus, searched for on every core
+        std::vector<BigNum> primes = GenerateSafePrimes(modulus_length / 2, 2);
+        return GenerateThresholdPaillierKeys(ctx, primes[0], primes[1], statistical_param);
+    }
+
+StatusOr<
+    std::pair<ThresholdPaillierKey, ThresholdPaillierKey>
+    > GenerateThresholdPaillierKeys(
+        Context* ctx,
+        const BigNum& p,
+        const BigNum& q,
+        int32_t statistical_param
+    ) {
+        if (p == q) {
+            return InvalidArgumentError("p and q must be distinct safe primes");
+        }
+        int32_t modulus_length = p.BitLength() + q.BitLength();
 
         // rsa modulus
         BigNum n = p * q;
@@ -82,7 +98,8 @@ Status GenerateThresholdPaillierKeys(
 ThresholdPaillier::~ThresholdPaillier() = default;
 
 ThresholdPaillier::ThresholdPaillier(Context* ctx, const BigNum& n, const BigNum& share)
-    : n(n), n_squared_(n * n), ctx_(ctx), share_(share) {
+    : n(n), n_squared_(n * n), ctx_(ctx), share_(share),
+      mont_ctx_(std::make_unique<MontContext>(ctx, n_squared_)) {
     paillier = std::make_unique<PublicPaillier>(this->ctx_, this->n);
 }
 
@@ -98,6 +115,14 @@ StatusOr<BigNum> ThresholdPaillier::ReRand(const BigNum& ciphertext) const {
     return paillier->ReRand(ciphertext);
 }
 
+Status ThresholdPaillier::PrecomputeRandomness(size_t count) {
+    return paillier->PrecomputeRandomness(count);
+}
+
+void ThresholdPaillier::StartBackgroundRandomness(size_t capacity) {
+    paillier->StartBackgroundRandomness(capacity);
+}
+
 StatusOr<BigNum> ThresholdPaillier::PartialDecrypt(const BigNum& c) const {
 
     if (!c.IsNonNegative()) {
@@ -111,7 +136,7 @@ StatusOr<BigNum> ThresholdPaillier::PartialDecrypt(const BigNum& c) const {
         );
     }
 
-    return c.ModExp(share_, n_squared_);
+    return mont_ctx_->ModExp(c, share_);
 }
 StatusOr<BigNum> ThresholdPaillier::Decrypt(
     const BigNum& c,
@@ -146,6 +171,51 @@ StatusOr<BigNum> ThresholdPaillier::Decrypt(
     }
 }
 
+StatusOr<std::vector<BigNum>> ThresholdPaillier::EncryptBatch(
+    const std::vector<BigNum>& messages
+) const {
+    std::vector<BigNum> ciphertexts(messages.size(), ctx_->Zero());
+    RETURN_IF_ERROR(ParallelFor(messages.size(), 1, [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+            ASSIGN_OR_RETURN(ciphertexts[i], paillier->Encrypt(messages[i]));
+        }
+        return OkStatus();
+    }));
+    return ciphertexts;
+}
+
+StatusOr<std::vector<BigNum>> ThresholdPaillier::PartialDecryptBatch(
+    const std::vector<BigNum>& cs
+) const {
+    std::vector<BigNum> partials(cs.size(), ctx_->Zero());
+    RETURN_IF_ERROR(ParallelFor(cs.size(), 1, [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+            ASSIGN_OR_RETURN(partials[i], PartialDecrypt(cs[i]));
+        }
+        return OkStatus();
+    }));
+    return partials;
+}
+
+StatusOr<std::vector<BigNum>> ThresholdPaillier::DecryptBatch(
+    const std::vector<BigNum>& cs,
+    const std::vector<BigNum>& partials
+) const {
+    if (cs.size() != partials.size()) {
+        return InvalidArgumentError(
+            "ThresholdPaillier::DecryptBatch() - Need one partial ciphertext per ciphertext."
+        );
+    }
+    std::vector<BigNum> messages(cs.size(), ctx_->Zero());
+    RETURN_IF_ERROR(ParallelFor(cs.size(), 1, [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+            ASSIGN_OR_RETURN(messages[i], Decrypt(cs[i], partials[i]));
+        }
+        return OkStatus();
+    }));
+    return messages;
+}
+
 BigNum ThresholdPaillier::Add(
     const BigNum& ciphertext1,
     const BigNum& ciphertext2
@@ -2,9 +2,11 @@
 #define upsi_CRYPTO_THRESHOLD_PAILLIER_H_
 
 #include <tuple>
+#include <vector>
 
 #include "upsi/crypto/big_num.h"
 #include "upsi/crypto/context.h"
+#include "upsi/crypto/mont_mul.h"
 #include "upsi/crypto/paillier.h"
 #include "upsi/crypto/paillier.pb.h"
 #include "upsi/util/status.inc"
@@ -15,6 +17,12 @@ StatusOr<std::pair<ThresholdPaillierKey, ThresholdPaillierKey>> GenerateThreshol
     Context* ctx, int32_t modulus_length, int32_t statistical_param
 );
 
+// same as above, but with modulus n = p * q for safe primes obtained elsewhere
+// (e.g. from a SafePrimeCache)
+StatusOr<std::pair<ThresholdPaillierKey, ThresholdPaillierKey>> GenerateThresholdPaillierKeys(
+    Context* ctx, const BigNum& p, const BigNum& q, int32_t statistical_param
+);
+
 // generate keys and put into given files
 Status GenerateThresholdPaillierKeys(
     Context* ctx,
@@ -46,9 +54,20 @@ class ThresholdPaillier {
         // rerandomizes the ciphertext
         StatusOr<BigNum> ReRand(const BigNum& ciphertext) const;
 
+        // precomputes randomizers for Encrypt and ReRand
+        // (see PublicPaillier::PrecomputeRandomness)
+        Status PrecomputeRandomness(size_t count);
+
+        // keeps up to capacity randomizers ready from a background thread
+        // (see PublicPaillier::StartBackgroundRandomness)
+        void StartBackgroundRandomness(size_t capacity);
+
         // partially decrypts the ciphertext with our share and
         //   returns the partial ciphertext as a BigNum
         //
+        // The exponentiation reuses the Montgomery context for n^2 that is
+        //   set up once in the constructor.
+        //
         // Returns INVALID_ARGUMENT status when the ciphertext is < 0 or >= n^(s+1).
         StatusOr<BigNum> PartialDecrypt(const BigNum& ciphertext) const;
 
@@ -57,6 +76,22 @@ class ThresholdPaillier {
         // Returns INVALID_ARGUMENT status when the ciphertext is < 0 or >= n^(s+1).
         StatusOr<BigNum> Decrypt(const BigNum& ciphertext, const BigNum& partial_ciphertext) const;
 
+        // batched versions of Encrypt, PartialDecrypt and Decrypt: the
+        //   entries are spread over worker threads and Encrypt draws its
+        //   randomizers from the precomputed pool while it has any
+        //
+        // Returns INVALID_ARGUMENT status if any entry would be rejected by
+        //   the single version, or if the two inputs of DecryptBatch differ
+        //   in size.
+        StatusOr<std::vector<BigNum>> EncryptBatch(const std::vector<BigNum>& messages) const;
+        StatusOr<std::vector<BigNum>> PartialDecryptBatch(
+            const std::vector<BigNum>& ciphertexts
+        ) const;
+        StatusOr<std::vector<BigNum>> DecryptBatch(
+            const std::vector<BigNum>& ciphertexts,
+            const std::vector<BigNum>& partial_ciphertexts
+        ) const;
+
         /**
          * homomorphically add two ciphertexts
          */
@@ -70,6 +105,9 @@ class ThresholdPaillier {
         Context* const ctx_;
         const BigNum share_;
 
+        // Montgomery constants for n^2, shared by every partial decryption
+        std::unique_ptr<MontContext> mont_ctx_;
+
         std::unique_ptr<PublicPaillier> paillier;
 };
 
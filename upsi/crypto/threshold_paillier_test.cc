@@ -3,6 +3,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "upsi/util/status_testing.inc"
 
 namespace upsi {
@@ -275,5 +277,84 @@ TEST(ThresholdPaillierTest, TestReRandomize2) {
 
     EXPECT_EQ(message, decrypted);
 }
+
+/**
+ * encryptions and rerandomizations drawing on precomputed randomness (both
+ * filled up front and by the background thread) still decrypt correctly and
+ * never reuse a randomizer
+ */
+TEST(ThresholdPaillierTest, TestPrecomputedRandomness) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(
+        auto keys, GenerateThresholdPaillierKeys(&ctx, modulus_length, statistical_param)
+    );
+
+    ThresholdPaillier party_one(&ctx, std::get<0>(keys));
+    ThresholdPaillier party_two(&ctx, std::get<1>(keys));
+
+    ASSERT_OK(party_one.PrecomputeRandomness(4));
+    party_two.StartBackgroundRandomness(4);
+
+    BigNum message = ctx.GenerateRandLessThan(ctx.CreateBigNum(std::get<0>(keys).n()));
+
+    std::vector<BigNum> ciphertexts;
+    for (int i = 0; i < 8; i++) {
+        ASSERT_OK_AND_ASSIGN(BigNum ciphertext, party_one.Encrypt(message));
+        ASSERT_OK_AND_ASSIGN(ciphertext, party_two.ReRand(ciphertext));
+        for (const BigNum& other : ciphertexts) {
+            EXPECT_NE(ciphertext, other);
+        }
+
+        ASSERT_OK_AND_ASSIGN(BigNum partial, party_two.PartialDecrypt(ciphertext));
+        ASSERT_OK_AND_ASSIGN(BigNum decrypted, party_one.Decrypt(ciphertext, partial));
+        EXPECT_EQ(message, decrypted);
+
+        ciphertexts.push_back(std::move(ciphertext));
+    }
+}
+
+/**
+ * the batch APIs agree with their single versions: a batch encrypted and
+ * partially decrypted by one party is fully decrypted by the other, and bad
+ * inputs are rejected
+ */
+TEST(ThresholdPaillierTest, TestBatch) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(
+        auto keys, GenerateThresholdPaillierKeys(&ctx, modulus_length, statistical_param)
+    );
+
+    ThresholdPaillier party_one(&ctx, std::get<0>(keys));
+    ThresholdPaillier party_two(&ctx, std::get<1>(keys));
+    ASSERT_OK(party_one.PrecomputeRandomness(5));
+
+    BigNum n = ctx.CreateBigNum(std::get<0>(keys).n());
+    std::vector<BigNum> messages;
+    for (int i = 0; i < 10; i++) {
+        messages.push_back(ctx.GenerateRandLessThan(n));
+    }
+
+    ASSERT_OK_AND_ASSIGN(std::vector<BigNum> ciphertexts, party_one.EncryptBatch(messages));
+    ASSERT_OK_AND_ASSIGN(std::vector<BigNum> partials, party_one.PartialDecryptBatch(ciphertexts));
+    ASSERT_EQ(partials.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); i++) {
+        EXPECT_THAT(party_one.PartialDecrypt(ciphertexts[i]), IsOkAndHolds(partials[i]));
+    }
+    EXPECT_THAT(party_two.DecryptBatch(ciphertexts, partials), IsOkAndHolds(messages));
+
+    EXPECT_THAT(
+        party_one.EncryptBatch({ ctx.Zero(), n }),
+        StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("not smaller"))
+    );
+    EXPECT_THAT(
+        party_one.PartialDecryptBatch({ n * n }),
+        StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("not smaller"))
+    );
+    partials.pop_back();
+    EXPECT_THAT(
+        party_two.DecryptBatch(ciphertexts, partials),
+        StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("partial"))
+    );
+}
 }
 }
@@ -130,8 +130,9 @@ std::vector<CryptoNode<T>> BaseTree<T, S>::insert(
 			int tmp_node_size = tmp_node.size();
 			//std::cerr << "tmp_node size  = " << tmp_node_size << std::endl;
 
+			std::vector<BinaryHash> node_hashes = computeBinaryHashes(tmp_node);
 			for (int i = 0; i < tmp_node_size; ++i) {
-				int x = computeIndex(computeBinaryHash(tmp_node[i]) );
+				int x = computeIndex(node_hashes[i]);
 				//if(u == 0 && i == 0) std::cerr<<"index is " << x << std::endl;
 				int steps = 0;
 				if(x != leaf_ind[o]) steps = 32 - __builtin_clz(x ^ leaf_ind[o]);
@@ -240,6 +241,13 @@ Status BaseTree<T, S>::Serialize(S* tree) {
 
 template<typename T, typename S>
 Status BaseTree<T, S>::Deserialize(const S& tree, Context* ctx, ECGroup* group) {
+    if (tree.has_curve_id() && tree.curve_id() != group->GetCurveId()) {
+        return InvalidArgumentError(
+            "[BaseTree] tree was built over " + CurveName(tree.curve_id()) +
+            " but the session uses " + CurveName(group->GetCurveId())
+        );
+    }
+
     this->stash_size = tree.stash_size();
     this->node_size = tree.node_size();
     this->actual_size = tree.actual_size();
@@ -488,8 +496,9 @@ std::vector<CryptoNode<ElementAndPayload>> CryptoTree<ElementAndPayload>::Insert
 			int tmp_node_size = tmp_node.size();
 			//std::cerr << "tmp_node size  = " << tmp_node_size << std::endl;
 
+			std::vector<BinaryHash> node_hashes = computeBinaryHashes(tmp_node);
 			for (int i = 0; i < tmp_node_size; ++i) {
-				int x = computeIndex(computeBinaryHash(tmp_node[i]));
+				int x = computeIndex(node_hashes[i]);
 				//if(u == 0 && i == 0) std::cerr<<"index is " << x << std::endl;
 				int steps = 0;
 				if(x != leaf_ind[o]) steps = 32 - __builtin_clz(x ^ leaf_ind[o]);
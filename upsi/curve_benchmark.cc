@@ -0,0 +1,85 @@
+#include "absl/status/status.h"
+
+#include "upsi/crypto/elgamal.h"
+#include "upsi/util/elgamal_proto_util.h"
+#include "upsi/utils.h"
+
+using namespace upsi;
+
+// number of elements to run each el gamal operation on
+#define BENCHMARK_SIZE 1000
+
+// curves to compare (ones the linked crypto library lacks are skipped)
+const std::vector<std::string> CURVES = { "P-224", "P-256", "P-384", "P-521", "secp256k1" };
+
+Status BenchmarkCurve(int curve_id) {
+    Context ctx;
+
+    ASSIGN_OR_RETURN(ECGroup group, ECGroup::Create(curve_id, &ctx));
+    ASSIGN_OR_RETURN(auto keys, elgamal::GenerateKeyPair(group));
+
+    ElGamalEncrypter encrypter(&group, std::move(keys.first));
+    ElGamalDecrypter decrypter(&ctx, &group, std::move(keys.second));
+
+    std::vector<Element> elements;
+    for (auto i = 0; i < BENCHMARK_SIZE; i++) {
+        elements.push_back(ctx.CreateBigNum(std::stoull(GetRandomSetElement())));
+    }
+
+    std::string name = CurveName(curve_id);
+
+    Timer encrypt("[Benchmark] " + name + " Encrypt");
+    std::vector<Ciphertext> ciphertexts;
+    for (const Element& element : elements) {
+        ASSIGN_OR_RETURN(auto ciphertext, encrypter.Encrypt(element));
+        ciphertexts.push_back(std::move(ciphertext));
+    }
+    encrypt.stop();
+
+    Timer exp("[Benchmark] " + name + " Exp");
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        BigNum mask = encrypter.CreateRandomMask();
+        ASSIGN_OR_RETURN(ciphertexts[i], elgamal::Exp(ciphertexts[i], mask));
+    }
+    exp.stop();
+
+    Timer dec("[Benchmark] " + name + " Decrypt");
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        ASSIGN_OR_RETURN(auto decrypted, decrypter.Decrypt(ciphertexts[i]));
+    }
+    dec.stop();
+
+    Timer serialize("[Benchmark] " + name + " Serialize");
+    size_t bytes = 0;
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        ASSIGN_OR_RETURN(
+            auto serialized, elgamal_proto_util::SerializeCiphertext(ciphertexts[i])
+        );
+        bytes += serialized.ByteSizeLong();
+    }
+    serialize.stop();
+
+    std::cout << "[Benchmark] " << name << " bytes per ciphertext\t: ";
+    std::cout << bytes / ciphertexts.size() << std::endl;
+
+    return OkStatus();
+}
+
+int main(int argc, char** argv) {
+    std::cout << ">> COMPARING CURVES (" << BENCHMARK_SIZE << " ELEMENTS) <<" << std::endl;
+
+    for (const std::string& curve : CURVES) {
+        auto curve_id = CurveIdFromName(curve);
+        if (!curve_id.ok()) {
+            std::cerr << curve_id.status() << std::endl;
+            return 1;
+        }
+
+        auto status = BenchmarkCurve(curve_id.value());
+        if (!status.ok()) {
+            std::cout << "[Benchmark] skipping " << curve << ": " << status << std::endl;
+        }
+    }
+
+    return 0;
+}
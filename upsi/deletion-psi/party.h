@@ -48,6 +48,9 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
             }
 
             this->pk = std::make_unique<PublicPaillier>(this->ctx_, pk.value());
+            if (params->paillier_pool > 0) {
+                this->pk->StartBackgroundRandomness(params->paillier_pool);
+            }
             
              if (params->start_size > 0) {
                 auto status = CreateMockTrees(params->start_size);
@@ -148,12 +151,12 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
 
                 if(element.second != this->ctx_->One()) {
                     BigNum p_times_q = this->pk->Multiply(path_i.second, value);
-                    gc_z_tmp.push_back(p_times_q);
+                    gc_z_tmp.push_back(std::move(p_times_q));
                 }
                 else {
                     gc_z_tmp.push_back(path_i.second);
                 }
-                res.push_back(tmp);
+                res.push_back(std::move(tmp));
             }
             gc_x.push_back(gc_x_tmp);
             gc_z.push_back(gc_z_tmp);
@@ -162,12 +165,18 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
         }
 
         Status CombinePathResponder(std::vector<std::vector<Element> > elements) {
-        	int cnt = elements.size();
-        	for (int i = 0; i < cnt; ++i) {
+        	// decrypt every path in one batch, then split the results back up
+        	std::vector<Element> flat;
+        	for (const std::vector<Element>& elements_i : elements) {
+        		flat.insert(flat.end(), elements_i.begin(), elements_i.end());
+        	}
+        	ASSIGN_OR_RETURN(std::vector<BigNum> decrypted, this->sk->DecryptBatch(flat));
+
+        	size_t p = 0;
+        	for (const std::vector<Element>& elements_i : elements) {
 				std::vector<BigNum> gc_y_tmp;
-		        for (const Element& elements_i: elements[i]) {
-		            ASSIGN_OR_RETURN(BigNum tmp, this->sk->Decrypt(elements_i));
-		            gc_y_tmp.push_back(tmp);
+		        for (size_t j = 0; j < elements_i.size(); ++j, ++p) {
+		            gc_y_tmp.push_back(std::move(decrypted[p]));
 		        }
 		        
 		        gc_y.push_back(gc_y_tmp);
@@ -182,19 +191,19 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
 
             std::vector<std::vector<bool> > my_bit;
 
-            bool bool_val[GC_SIZE];
             std::vector<emp::Integer> a[cnt], b[cnt];
             for (int i = 0; i < cnt; ++i) {
             	int cnt_vct;
             	if(is_sender) cnt_vct = gc_x[i].size();
             	else cnt_vct = gc_y[i].size();
             	tot_cnt += cnt_vct;
+            	std::unique_ptr<bool[]> bool_val(new bool[cnt_vct * GC_SIZE]);
+            	if(is_sender) BigNum2bool(gc_x[i], bool_val.get());
+            	else BigNum2bool(gc_y[i], bool_val.get());
             	for (int j = 0; j < cnt_vct; ++j) {
-		            if(is_sender) BigNum2bool(gc_x[i][j], bool_val);
-		            else BigNum2bool(gc_y[i][j], bool_val);
 		            emp::Integer a_tmp, b_tmp;
-		            a_tmp.init(bool_val, GC_SIZE, emp::ALICE);
-		            b_tmp.init(bool_val, GC_SIZE, emp::BOB);
+		            a_tmp.init(&bool_val[j * GC_SIZE], GC_SIZE, emp::ALICE);
+		            b_tmp.init(&bool_val[j * GC_SIZE], GC_SIZE, emp::BOB);
 		            a[i].push_back(a_tmp);
 		            b[i].push_back(b_tmp);
 				}
@@ -205,11 +214,13 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
             	if(is_sender) cnt_vct = gc_x[i].size();
             	else cnt_vct = gc_y[i].size();
             	std::vector<bool> my_bit_tmp;
+            	std::vector<bool> mask_bits;
+            	if(gc_party == emp::ALICE) mask_bits = ContextPool::GetDrbg()->GenerateBits(cnt_vct);
             	for (int j = 0; j < cnt_vct; ++j) {
 		            Bit eq(true);
 		            bool cur_bit = 0;
 		            if(gc_party == emp::ALICE) {
-		            	cur_bit = rand() & 1;
+		            	cur_bit = mask_bits[j];
 		            	my_bit_tmp.push_back(cur_bit);
 		            }
 		            emp::Bit tmp(cur_bit ^ 1, emp::ALICE);
@@ -293,13 +304,20 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
             if(is_sender) ot_sender->send(block_zero, block_one, cnt_block * tot_cnt);
             else {
             	ot_receiver->recv(block_zero, chosen_bit, cnt_block * tot_cnt);
+
+            	std::vector<BigNum> received;
+            	received.reserve(tot_cnt);
+            	for (int k = 0; k < tot_cnt; ++k) {
+            		received.push_back(block2BigNum(&block_zero[cnt_block * k], cnt_block, ctx_));
+            	}
+            	ASSIGN_OR_RETURN(std::vector<BigNum> decrypted, this->sk->DecryptBatch(received));
+
             	p = 0;
 		        for (int i = 0; i < cnt; ++i) {
 		        	BigNum rs = ctx_->Zero();
 		        	int cnt_vct = my_bit[i].size();
 		        	for (int j = 0; j < cnt_vct; ++j, ++p) {
-				    	ASSIGN_OR_RETURN(BigNum tmp, this->sk->Decrypt(block2BigNum(&block_zero[cnt_block * p], cnt_block, ctx_)));
-		                rs = rs + tmp;
+		                rs = rs + decrypted[p];
 		        	}
 		        	
 		            rs = rs.Mod(cur_n); //with ?? probability one < cur_n/2, the other > cur_n/2
@@ -61,9 +61,7 @@ Status PartyOne::SecondPhase() {
 		msg.push_back(encrypted_rs);
 	}
 	
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::shuffle(msg.begin(), msg.end(), gen);
+	std::shuffle(msg.begin(), msg.end(), *ContextPool::GetDrbg());
 	
 	for (int i = 0; i < cnt; ++i) {
 		std::string tmp_str = msg[i].ToBytes();
@@ -3,6 +3,7 @@
 #include "emp-sh2pc/emp-sh2pc.h"
 
 #include "upsi/crypto/paillier.h"
+#include "upsi/crypto/paillier_packing.h"
 #include "upsi/roles.h"
 #include "upsi/util/gc_util.h"
 #include "upsi/util/proto_util.h"
@@ -30,12 +31,15 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
 
         int gc_party;
 
+        // whether GarbledCircuit sends its outputs as packed ciphertexts
+        bool use_packing;
+
         std::vector<uint64_t> comm_, comm_gc;
 
     public:
         Party(
             PSIParams* params, int gc_party
-        ) : HasTree<ElementAndPayload, PaillierPair>(params), gc_party(gc_party), comm_(params->total_days), comm_gc(params->total_days) {
+        ) : HasTree<ElementAndPayload, PaillierPair>(params), gc_party(gc_party), use_packing(params->paillier_packing), comm_(params->total_days), comm_gc(params->total_days) {
             auto sk = ProtoUtils::ReadProtoFromFile<PaillierPrivateKey>(params->psk_fn);
             if (!sk.ok()) {
                 std::runtime_error("[Party] failure in reading paillier secret key");
@@ -49,6 +53,9 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
             }
 
             this->pk = std::make_unique<PublicPaillier>(this->ctx_, pk.value());
+            if (params->paillier_pool > 0) {
+                this->pk->StartBackgroundRandomness(params->paillier_pool);
+            }
 
             if (params->start_size > 0) {
                 auto status = CreateMockTrees(params->start_size);
@@ -147,22 +154,22 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
 
                 if(element.second != this->ctx_->One()) {
                     BigNum p_times_q = this->pk->Multiply(path_i.second, value);
-                    gc_z.push_back(p_times_q);
+                    gc_z.push_back(std::move(p_times_q));
                 }
                 else {
                     gc_z.push_back(path_i.second);
                 }
 
-                res.push_back(tmp);
+                res.push_back(std::move(tmp));
             }
 
             return res;
         }
 
         Status CombinePathResponder(std::vector<Element> elements) {
-            for (const Element& elements_i: elements) {
-                ASSIGN_OR_RETURN(BigNum tmp, this->sk->Decrypt(elements_i));
-                gc_y.push_back(tmp);
+            ASSIGN_OR_RETURN(std::vector<BigNum> decrypted, this->sk->DecryptBatch(elements));
+            for (BigNum& tmp : decrypted) {
+                gc_y.push_back(std::move(tmp));
             }
 
             return OkStatus();
@@ -175,20 +182,22 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
 
             std::vector<bool> my_bit;
 
-            bool bool_val[GC_SIZE];
+            std::unique_ptr<bool[]> bool_val(new bool[cnt * GC_SIZE]);
+            if(is_sender) BigNum2bool(gc_x, bool_val.get());
+            else BigNum2bool(gc_y, bool_val.get());
             emp::Integer a[cnt], b[cnt];
             for (int i = 0; i < cnt; ++i) {
-                if(is_sender) BigNum2bool(gc_x[i], bool_val);
-                else BigNum2bool(gc_y[i], bool_val);
-                a[i].init(bool_val, GC_SIZE, emp::ALICE);
-                b[i].init(bool_val, GC_SIZE, emp::BOB);
+                a[i].init(&bool_val[i * GC_SIZE], GC_SIZE, emp::ALICE);
+                b[i].init(&bool_val[i * GC_SIZE], GC_SIZE, emp::BOB);
 			}
 			emp::Bit eq_vct[cnt];
+            std::vector<bool> mask_bits;
+            if(gc_party == emp::ALICE) mask_bits = ContextPool::GetDrbg()->GenerateBits(cnt);
 			for (int i = 0; i < cnt; ++i) {
                 Bit eq(true);
                 bool cur_bit = 0;
                 if(gc_party == emp::ALICE) {
-                	cur_bit = rand() & 1;
+                	cur_bit = mask_bits[i];
                 	my_bit.push_back(cur_bit);
                 }
                 emp::Bit tmp(cur_bit ^ 1, emp::ALICE);
@@ -208,6 +217,8 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
                 if(gc_party == emp::BOB) my_bit.push_back(cur_bit);
             }
 
+            if (use_packing) { return PackedOutput(is_sender, my_bit); }
+
             BigNum rs = ctx_->Zero();
 
             int len = 0, cnt_block = 0;
@@ -252,8 +263,13 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
             else {
             	ot_receiver->recv(block_zero, chosen_bit, cnt_block * cnt);
             	
+				std::vector<BigNum> received;
+				received.reserve(cnt);
 				for (int i = 0; i < cnt; ++i) {
-                    ASSIGN_OR_RETURN(BigNum tmp, this->sk->Decrypt(block2BigNum(&block_zero[cnt_block * i], cnt_block, ctx_)));
+                    received.push_back(block2BigNum(&block_zero[cnt_block * i], cnt_block, ctx_));
+                }
+                ASSIGN_OR_RETURN(std::vector<BigNum> decrypted, this->sk->DecryptBatch(received));
+                for (const BigNum& tmp : decrypted) {
                     rs = rs + tmp;
                 }
             }
@@ -277,6 +293,88 @@ class Party : public HasTree<ElementAndPayload, PaillierPair> {
             return rs_;
         }
 
+        /**
+         * output step of GarbledCircuit with packed ciphertexts
+         *
+         * for candidate i the sender fills two slots, one per choice bit of
+         * the receiver: z_i goes in the slot of the sender's own bit and 0 in
+         * the other, and both are masked by r + 2^(PACKED_VALUE_BITS - 1).
+         * the receiver decrypts every slot and obtains the mask of the slot
+         * it chose, offset by a random beta_i, with one OT block; its share is
+         * the difference and the sender's share is beta_i, both mod 2^64
+         */
+        StatusOr<uint64_t> PackedOutput(bool is_sender, const std::vector<bool>& my_bit) {
+            int cnt = my_bit.size();
+            BigNum cur_n = is_sender ? this->pk->n() : this->sk->n();
+            PaillierPacking packing(this->ctx_, cur_n, PACKED_VALUE_BITS + PACKED_STAT_BITS + 1);
+            size_t num_packed = packing.NumPacked(2 * cnt);
+
+            int cnt_block = (cur_n.ToBytes().length() * 2 + 15) >> 4;
+            int msg_len = cnt_block << 4;
+
+            std::vector<emp::block> block_zero(cnt), block_one(cnt);
+            uint64_t rs = 0;
+
+            if (is_sender) {
+                BigNum offset = this->ctx_->One().Lshift(PACKED_VALUE_BITS - 1);
+                std::vector<BigNum> masks = ContextPool::GetDrbg()->GenerateRandLessThan(
+                    this->ctx_->One().Lshift(PACKED_VALUE_BITS + PACKED_STAT_BITS), 2 * cnt
+                );
+
+                std::vector<BigNum> slots, ciphertexts;
+                slots.reserve(2 * cnt);
+                ciphertexts.reserve(2 * cnt);
+                for (int i = 0; i < cnt; ++i) {
+                    uint64_t beta = generateRandom64bits();
+                    for (int c = 0; c < 2; ++c) {
+                        BigNum slot = masks[2 * i + c] + offset;
+                        uint64_t message = BigNum2uint64(slot) + beta;
+                        BigNum2block(this->ctx_->CreateBigNum(message), c == 0 ? &block_zero[i] : &block_one[i], 1);
+                        slots.push_back(std::move(slot));
+
+                        if (c == my_bit[i]) ciphertexts.push_back(gc_z[i]);
+                        else ciphertexts.push_back(this->ctx_->One());
+                    }
+                    rs += beta;
+                }
+
+                ASSIGN_OR_RETURN(std::vector<BigNum> packed, packing.EncryptPacked(*this->pk, slots));
+                ASSIGN_OR_RETURN(packed, packing.AddPacked(*this->pk, packed, ciphertexts));
+                for (const BigNum& ciphertext : packed) {
+                    std::string bytes = ciphertext.ToBytes();
+                    PadBytes(bytes, msg_len);
+                    gc_io_->send_data(&bytes[0], msg_len);
+                }
+                gc_io_->flush();
+
+                ot_sender->send(block_zero.data(), block_one.data(), cnt);
+            }
+            else {
+                std::vector<BigNum> packed;
+                packed.reserve(num_packed);
+                for (size_t k = 0; k < num_packed; ++k) {
+                    std::string bytes(msg_len, 0);
+                    gc_io_->recv_data(&bytes[0], msg_len);
+                    packed.push_back(this->ctx_->CreateBigNum(bytes));
+                }
+
+                std::unique_ptr<bool[]> chosen_bit(new bool[cnt]);
+                for (int i = 0; i < cnt; ++i) chosen_bit[i] = my_bit[i];
+                ot_receiver->recv(block_zero.data(), chosen_bit.get(), cnt);
+
+                ASSIGN_OR_RETURN(
+                    std::vector<BigNum> slots,
+                    packing.DecryptPacked(*this->sk, packed, 2 * cnt)
+                );
+                for (int i = 0; i < cnt; ++i) {
+                    uint64_t mask = BigNum2uint64(block2BigNum(&block_zero[i], 1, this->ctx_));
+                    rs += BigNum2uint64(slots[2 * i + my_bit[i]]) - mask;
+                }
+            }
+
+            return rs;
+        }
+
         StatusOr<uint64_t> GarbledCircuit() {
             uint64_t rs1, rs2;
             if(gc_party == emp::ALICE) {
@@ -45,6 +45,7 @@ ABSL_FLAG(int, days, 10, "total days the protocol will run for");
 
 ABSL_FLAG(bool, import, false, "use initial trees stored on disk");
 ABSL_FLAG(int, start_size, -1, "size of the initial trees (if creating random)");
+ABSL_FLAG(int, paillier_pool, 0, "paillier randomizers precomputed in the background (0 disables)");
 
 Status RunPartyZero() {
     Context context;
@@ -55,6 +56,7 @@ Status RunPartyZero() {
         absl::GetFlag(FLAGS_out_dir) + "p0/paillier.key",
         absl::GetFlag(FLAGS_days)
     );
+    params.paillier_pool = absl::GetFlag(FLAGS_paillier_pool);
 
     // because we are allowing single additions and deletions
     params.stash_size = 2 * DEFAULT_STASH_SIZE;
@@ -151,6 +153,7 @@ Status RunPartyOne() {
         absl::GetFlag(FLAGS_out_dir) + "p1/paillier.key",
         absl::GetFlag(FLAGS_days)
     );
+    params.paillier_pool = absl::GetFlag(FLAGS_paillier_pool);
 
     // because we are allowing single additions and deletions
     params.stash_size = 2 * DEFAULT_STASH_SIZE;
@@ -25,6 +25,7 @@ ABSL_FLAG(std::string, shared_fn, "shared", "prefix for shared key file");
 
 ABSL_FLAG(int32_t, mod_length, 1536, "bit-length of Paillier modulus");
 ABSL_FLAG(int32_t, stat_param, 100, "statistical parameter for Paillier");
+ABSL_FLAG(std::string, prime_cache, "", "file of reusable safe primes for the Paillier keys (testing only)");
 
 ABSL_FLAG(uint32_t, days, 10, "number of days the protocol is running for");
 ABSL_FLAG(uint32_t, daily_size, 64, "total elements in each set on each day");
@@ -87,7 +88,8 @@ int main(int argc, char** argv) {
             absl::GetFlag(FLAGS_out_dir) + "p0/",
             absl::GetFlag(FLAGS_out_dir) + "p1/",
             absl::GetFlag(FLAGS_mod_length),
-            absl::GetFlag(FLAGS_stat_param)
+            absl::GetFlag(FLAGS_stat_param),
+            absl::GetFlag(FLAGS_prime_cache)
         );
         if (!status.ok()) {
             std::cerr << "[Setup] failure generating keys" << std::endl;
@@ -2,6 +2,7 @@
 
 #include <thread>
 
+#include "upsi/crypto/object_pool.h"
 #include "upsi/util/status.inc"
 
 namespace upsi {
@@ -56,6 +57,8 @@ class ServerSink : public MessageSink<ServerMessage> {
 ) {
     ServerSink sink(response);
     auto status = server->Handle(*request, &sink);
+    // hand this message's cached bignums and points back to malloc
+    ObjectPool::Release();
     return ConvertStatus(status);
 }
 
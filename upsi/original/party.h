@@ -33,7 +33,7 @@ class Party {
                 this->datasets[day] = datasets[day].Elements();
             }
 
-            this->group = new ECGroup(ECGroup::Create(CURVE_ID, ctx_).value());
+            this->group = new ECGroup(ECGroup::Create(params->curve_id, ctx_).value());
 
             auto epk = ProtoUtils::ReadProtoFromFile<ElGamalPublicKey>(params->epk_fn);
             if (!epk.ok()) {
@@ -62,6 +62,7 @@ class Party {
 
             decrypter = std::make_unique<ElGamalDecrypter>(
                 this->ctx_,
+                this->group,
                 elgamal_proto_util::DeserializePrivateKey(this->ctx_, esk.value()).value()
             );
         }
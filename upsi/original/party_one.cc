@@ -43,12 +43,19 @@ Status PartyOne::SendMessageI(MessageSink<ClientMessage>* sink) {
         this->ctx_, this->my_pk.get(), elements, msg.mutable_updates()
     ));
 
-    for (size_t i = 0; i < elements.size(); ++i) {
-        ASSIGN_OR_RETURN(
-            ECPoint hx, this->group->GetPointByHashingToCurveSha256(elements[i].ToBytes())
-        );
-        ASSIGN_OR_RETURN(ECPoint hx_to_a, hx.Mul(this->decrypter->getPrivateKey()->x));
-        ASSIGN_OR_RETURN(auto serialized, hx_to_a.ToBytesCompressed());
+    std::vector<std::string> messages;
+    messages.reserve(elements.size());
+    for (const Element& element : elements) {
+        messages.push_back(element.ToBytes());
+    }
+    ASSIGN_OR_RETURN(
+        std::vector<ECPoint> hx_to_a,
+        this->group->HashToCurveAndMulBatch(
+            messages, HASH_TO_CURVE_DST, this->decrypter->getPrivateKey()->x
+        )
+    );
+    for (const ECPoint& point : hx_to_a) {
+        ASSIGN_OR_RETURN(auto serialized, point.ToBytesCompressed());
         msg.add_ciphertexts(serialized);
     }
 
@@ -88,9 +95,7 @@ Status PartyOne::SendMessageIII(
             outgoing.push_back(std::move(gamma_x_beta_minus_alpha));
         }
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::shuffle(outgoing.begin(), outgoing.end(), gen);
+        std::shuffle(outgoing.begin(), outgoing.end(), *ContextPool::GetDrbg());
 
         auto encrypted_set = msg.add_candidates();
         for (size_t i = 0; i < outgoing.size(); i++) {
@@ -114,8 +119,15 @@ Status PartyOne::SendMessageV(
     OriginalMessage::MessageV msg;
     for (const auto& ciphertext : res.ciphertexts()) {
         ASSIGN_OR_RETURN(ECPoint hy_to_am, this->group->CreateECPoint(ciphertext));
-        ASSIGN_OR_RETURN(ECPoint hy_to_abm, hy_to_am.Mul(this->decrypter->getPrivateKey()->x));
-        ASSIGN_OR_RETURN(auto serialized, hy_to_abm.ToBytesCompressed());
+        ciphertexts.push_back(std::move(hy_to_am));
+    }
+
+    ASSIGN_OR_RETURN(
+        std::vector<ECPoint> hy_to_abm,
+        this->group->MulBatch(ciphertexts, this->decrypter->getPrivateKey()->x)
+    );
+    for (const ECPoint& point : hy_to_abm) {
+        ASSIGN_OR_RETURN(auto serialized, point.ToBytesCompressed());
         msg.add_ciphertexts(serialized);
     }
 
@@ -15,6 +15,17 @@
 namespace upsi {
 namespace original {
 
+Status PartyZero::LoadIndex(const OPRF& oprf) {
+    if (!oprf.has_index()) {
+        // older setups only wrote the (x, H(x)^ab) pairs, hashed to the curve
+        // in a way that no longer matches what party one sends
+        return InvalidArgumentError(
+            "[PartyZero] OPRF file predates the current hash to curve; rerun setup"
+        );
+    }
+    return index.Deserialize(oprf.index());
+}
+
 Status PartyZero::Handle(const ClientMessage& msg, MessageSink<ServerMessage>* sink) {
     if (ProtocolFinished()) {
         return InvalidArgumentError("[PartyZero] protocol is already complete");
@@ -48,12 +59,21 @@ Status PartyZero::SendMessageII(
 
     RETURN_IF_ERROR(tree.Update(this->ctx_, this->group, &req.updates()));
 
+    std::vector<ECPoint> hy_to_a;
     for (const auto& ciphertext : req.ciphertexts()) {
-        ASSIGN_OR_RETURN(ECPoint hy_to_a, this->group->CreateECPoint(ciphertext));
-        ASSIGN_OR_RETURN(ECPoint hy_to_ab, hy_to_a.Mul(this->decrypter->getPrivateKey()->x));
-        ASSIGN_OR_RETURN(auto key, hy_to_ab.ToBytesUnCompressed());
-        if (group_mapping.count(key) > 0) {
-            intersection.push_back(group_mapping[key]);
+        ASSIGN_OR_RETURN(ECPoint point, this->group->CreateECPoint(ciphertext));
+        hy_to_a.push_back(std::move(point));
+    }
+
+    ASSIGN_OR_RETURN(
+        std::vector<ECPoint> hy_to_ab,
+        this->group->MulBatch(hy_to_a, this->decrypter->getPrivateKey()->x)
+    );
+    for (const ECPoint& point : hy_to_ab) {
+        ASSIGN_OR_RETURN(uint64_t fingerprint, IntersectionIndex::Fingerprint(point));
+        std::optional<uint64_t> element = index.Find(fingerprint);
+        if (element.has_value()) {
+            intersection.push_back(std::to_string(*element));
         }
     }
 
@@ -114,6 +134,8 @@ Status PartyZero::SendMessageIV(
     OriginalMessage::MessageIV msg;
     this->masks.clear();
     uint32_t n = 0;
+    std::vector<std::string> messages;
+    std::vector<BigNum> scalars;
     for (int i = 0; i < res.candidates().size(); i++) {
         ASSIGN_OR_RETURN(
             std::vector<Ciphertext> candidates,
@@ -125,8 +147,8 @@ Status PartyZero::SendMessageIV(
         n += candidates.size();
         bool in_intersection = false;
         for (const Ciphertext& candidate : candidates) {
-            ASSIGN_OR_RETURN(ECPoint decrypted, this->decrypter->Decrypt(candidate));
-            if (decrypted.IsPointAtInfinity()) {
+            ASSIGN_OR_RETURN(bool is_zero, this->decrypter->IsEncryptionOfZero(candidate));
+            if (is_zero) {
                 this->intersection.push_back(datasets[current_day][i].ToDecimalString());
                 in_intersection = true;
                 break;
@@ -134,29 +156,30 @@ Status PartyZero::SendMessageIV(
         }
 
         if (in_intersection) {
+            // stand in a random point for elements we already know about
             BigNum r = this->ctx_->GenerateRandLessThan(this->group->GetOrder());
-            ASSIGN_OR_RETURN(
-                ECPoint hr, this->group->GetPointByHashingToCurveSha256(r.ToBytes())
-            );
-
-            ASSIGN_OR_RETURN(auto serialized, hr.ToBytesCompressed());
-            msg.add_ciphertexts(serialized);
+            messages.push_back(r.ToBytes());
+            scalars.push_back(ctx_->One());
             this->masks.push_back(ctx_->Zero());
         } else {
-            ASSIGN_OR_RETURN(
-                ECPoint hx,
-                this->group->GetPointByHashingToCurveSha256(datasets[current_day][i].ToBytes())
-            );
-            ASSIGN_OR_RETURN(ECPoint hx_to_a, hx.Mul(this->decrypter->getPrivateKey()->x));
-
+            // H(x)^(a * mask)
             BigNum mask = this->my_pk->CreateRandomMask();
-            ASSIGN_OR_RETURN(ECPoint hx_to_am, hx_to_a.Mul(mask));
-
-            ASSIGN_OR_RETURN(auto serialized, hx_to_am.ToBytesCompressed());
-            msg.add_ciphertexts(serialized);
+            messages.push_back(datasets[current_day][i].ToBytes());
+            scalars.push_back(
+                this->decrypter->getPrivateKey()->x.ModMul(mask, this->group->GetOrder())
+            );
             this->masks.push_back(mask);
         }
     }
+
+    ASSIGN_OR_RETURN(
+        std::vector<ECPoint> points, this->group->HashToCurveBatch(messages, HASH_TO_CURVE_DST)
+    );
+    ASSIGN_OR_RETURN(points, this->group->MulBatch(points, scalars));
+    for (const ECPoint& point : points) {
+        ASSIGN_OR_RETURN(auto serialized, point.ToBytesCompressed());
+        msg.add_ciphertexts(serialized);
+    }
     std::cout << "[DEBUG] candidates.size() = " << n << std::endl;
 
     ServerMessage sm;
@@ -172,8 +195,9 @@ Status PartyZero::ProcessMessageV(const OriginalMessage::MessageV& res) {
         ASSIGN_OR_RETURN(ECPoint hx_to_abm, this->group->CreateECPoint(res.ciphertexts()[i]));
         ASSIGN_OR_RETURN(BigNum minus_mask, this->masks[i].ModInverse(this->group->GetOrder()));
         ASSIGN_OR_RETURN(ECPoint hx_to_ab, hx_to_abm.Mul(minus_mask));
-        ASSIGN_OR_RETURN(auto key, hx_to_ab.ToBytesUnCompressed());
-        group_mapping[key] = datasets[current_day][i].ToDecimalString();
+        ASSIGN_OR_RETURN(uint64_t fingerprint, IntersectionIndex::Fingerprint(hx_to_ab));
+        ASSIGN_OR_RETURN(uint64_t element, datasets[current_day][i].ToIntValue());
+        index.Insert(fingerprint, element);
     }
 
     return OkStatus();
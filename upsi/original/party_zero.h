@@ -6,6 +6,7 @@
 #include "upsi/roles.h"
 #include "upsi/network/upsi.pb.h"
 #include "upsi/util/data_util.h"
+#include "upsi/util/intersection_index.h"
 #include "upsi/util/status.inc"
 #include "upsi/utils.h"
 
@@ -34,11 +35,13 @@ class PartyZero : public Server, public Party {
                 }
 
                 auto oprf = ProtoUtils::ReadProtoFromFile<OPRF>(params->oprf_fn);
-                for (const auto& kv : oprf.value().kv()) {
-                    std::string element = kv.element();
-                    auto output = this->group->CreateECPoint(kv.output());
-                    auto key = output.value().ToBytesUnCompressed();
-                    group_mapping[key.value()] = element;
+                if (!oprf.ok()) {
+                    throw std::runtime_error("[PartyZero] error reading OPRF");
+                }
+                load = LoadIndex(oprf.value());
+                if (!load.ok()) {
+                    std::cerr << load << std::endl;
+                    throw std::runtime_error("[PartyZero] error loading OPRF");
                 }
             }
         }
@@ -63,11 +66,16 @@ class PartyZero : public Server, public Party {
         void PrintResult() override;
 
     protected:
+        /**
+         * fill the index from the H(x)^ab written by setup
+         */
+        Status LoadIndex(const OPRF& oprf);
+
         // their encrypted set
         CryptoTree<Ciphertext> tree;
 
         // maps H(x)^ab to x
-        std::map<std::string, std::string> group_mapping;
+        IntersectionIndex index;
 
         // elements in the intersection
         std::vector<std::string> intersection;
@@ -28,6 +28,7 @@
 #include "upsi/network/upsi.pb.h"
 #include "upsi/util/status.inc"
 #include "upsi/util/data_util.h"
+#include "upsi/util/elgamal_key_util.h"
 #include "upsi/utils.h"
 
 using namespace upsi;
@@ -53,6 +54,9 @@ Status RunPartyZero() {
         absl::GetFlag(FLAGS_days)
     );
 
+    // run over whichever curve the keys were generated on
+    ASSIGN_OR_RETURN(params.curve_id, elgamal_key_util::ReadCurveId(params.epk_fn));
+
     if (absl::GetFlag(FLAGS_trees)) {
         params.my_tree_fn = absl::GetFlag(FLAGS_data_dir) + "p0/encrypted.tree";
         params.oprf_fn = absl::GetFlag(FLAGS_data_dir) + "p0/elements.ec";
@@ -113,6 +117,9 @@ Status RunPartyOne() {
         absl::GetFlag(FLAGS_days)
     );
 
+    // run over whichever curve the keys were generated on
+    ASSIGN_OR_RETURN(params.curve_id, elgamal_key_util::ReadCurveId(params.epk_fn));
+
     if (absl::GetFlag(FLAGS_trees)) {
         params.my_tree_fn = absl::GetFlag(FLAGS_data_dir) + "p1/plaintext.tree";
     }
@@ -7,6 +7,7 @@
 #include "upsi/util/data_util.h"
 #include "upsi/util/elgamal_key_util.h"
 #include "upsi/util/elgamal_proto_util.h"
+#include "upsi/util/intersection_index.h"
 #include "upsi/util/proto_util.h"
 #include "upsi/util/setup_util.h"
 #include "upsi/utils.h"
@@ -36,6 +37,8 @@ ABSL_FLAG(Functionality, func, Functionality::CA, "which functionality to prepar
 
 ABSL_FLAG(bool, expected, true, "compute expected cardinality and sum");
 
+ABSL_FLAG(std::string, curve, "P-256", "elliptic curve for the el gamal keys (P-224, P-256, P-384, P-521)");
+
 Status WriteHX(Context* ctx, ECGroup* group, const Dataset& p0_tree) {
 
     ASSIGN_OR_RETURN(
@@ -45,7 +48,7 @@ Status WriteHX(Context* ctx, ECGroup* group, const Dataset& p0_tree) {
         )
     );
 
-    ElGamalDecrypter p0(ctx, elgamal_proto_util::DeserializePrivateKey(ctx, sk0).value());
+    ElGamalDecrypter p0(ctx, group, elgamal_proto_util::DeserializePrivateKey(ctx, sk0).value());
 
     ASSIGN_OR_RETURN(
         ElGamalSecretKey sk1,
@@ -54,19 +57,33 @@ Status WriteHX(Context* ctx, ECGroup* group, const Dataset& p0_tree) {
         )
     );
 
-    ElGamalDecrypter p1(ctx, elgamal_proto_util::DeserializePrivateKey(ctx, sk1).value());
+    ElGamalDecrypter p1(ctx, group, elgamal_proto_util::DeserializePrivateKey(ctx, sk1).value());
 
-    OPRF oprf;
-    for (const BigNum& x : p0_tree.Elements()) {
-        ASSIGN_OR_RETURN(ECPoint hx, group->GetPointByHashingToCurveSha256(x.ToBytes()));
-        ASSIGN_OR_RETURN(ECPoint hx_to_a, hx.Mul(p0.getPrivateKey()->x));
-        ASSIGN_OR_RETURN(ECPoint hx_to_ab, hx_to_a.Mul(p1.getPrivateKey()->x));
-        ASSIGN_OR_RETURN(auto serialized, hx_to_ab.ToBytesUnCompressed());
-        auto kv = oprf.add_kv();
-        kv->set_element(x.ToDecimalString());
-        kv->set_output(serialized);
+    std::vector<BigNum> elements = p0_tree.Elements();
+    std::vector<std::string> messages;
+    messages.reserve(elements.size());
+    for (const BigNum& x : elements) {
+        messages.push_back(x.ToBytes());
+    }
+    ASSIGN_OR_RETURN(
+        std::vector<ECPoint> hx_to_ab,
+        group->HashToCurveAndMulBatch(
+            messages, HASH_TO_CURVE_DST,
+            p0.getPrivateKey()->x.ModMul(p1.getPrivateKey()->x, group->GetOrder())
+        )
+    );
+
+    IntersectionIndex index;
+    index.Reserve(elements.size());
+    for (size_t i = 0; i < elements.size(); i++) {
+        ASSIGN_OR_RETURN(uint64_t fingerprint, IntersectionIndex::Fingerprint(hx_to_ab[i]));
+        ASSIGN_OR_RETURN(uint64_t id, elements[i].ToIntValue());
+        index.Insert(fingerprint, id);
     }
 
+    OPRF oprf;
+    index.Serialize(oprf.mutable_index());
+
     RETURN_IF_ERROR(
         ProtoUtils::WriteProtoToFile(oprf, absl::GetFlag(FLAGS_data_dir) + "p0/elements.ec")
     );
@@ -107,7 +124,11 @@ Status GenerateData(Context* ctx) {
 
     if (start_size > 0) {
         std::cout << "[Setup] writing initial tree" << std::flush;
-        ECGroup group(ECGroup::Create(CURVE_ID, ctx).value());
+        // build the trees over whichever curve the keys were generated on
+        ASSIGN_OR_RETURN(
+            int curve_id, elgamal_key_util::ReadCurveId(p1_key_dir + "elgamal.pub")
+        );
+        ASSIGN_OR_RETURN(ECGroup group, ECGroup::Create(curve_id, ctx));
         RETURN_IF_ERROR(
             GenerateTrees(
                 ctx, &group, p1_tree.Elements(), p1_key_dir, p1_dir, p0_dir, "elgamal.pub"
@@ -145,10 +166,16 @@ int main(int argc, char** argv) {
     Context ctx;
 
     if (absl::GetFlag(FLAGS_keys)) {
+        auto curve_id = CurveIdFromName(absl::GetFlag(FLAGS_curve));
+        if (!curve_id.ok()) {
+            std::cerr << "[Setup] " << curve_id.status() << std::endl;
+            return 1;
+        }
         auto status = GenerateElGamalKeys(
             &ctx,
             absl::GetFlag(FLAGS_out_dir) + "p0/",
-            absl::GetFlag(FLAGS_out_dir) + "p1/"
+            absl::GetFlag(FLAGS_out_dir) + "p1/",
+            curve_id.value()
         );
         if (!status.ok()) {
             std::cerr << "[Setup] failure generating keys" << std::endl;
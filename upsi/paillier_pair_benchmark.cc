@@ -0,0 +1,130 @@
+#include "absl/status/status.h"
+
+#include "upsi/crypto/packed_paillier_pair.h"
+#include "upsi/crypto/paillier.h"
+#include "upsi/network/upsi.pb.h"
+#include "upsi/utils.h"
+
+using namespace upsi;
+
+// number of tree slots encrypted, combined and decrypted per layout
+#define BENCHMARK_SIZE 200
+
+// paillier modulus length used for both layouts
+#define MODULUS_LENGTH 2048
+
+/**
+ * current layout: element and payload as two s = 1 ciphertexts
+ */
+Status RunTwoCiphertexts(Context* ctx, const std::vector<ElementAndPayload>& slots) {
+    ASSIGN_OR_RETURN(auto keys, GeneratePaillierKeyPair(ctx, MODULUS_LENGTH, 1));
+    PublicPaillier pk(ctx, std::get<0>(keys));
+    PrivatePaillier sk(ctx, std::get<1>(keys));
+    BigNum value = ctx->CreateBigNum(3);
+
+    Timer encrypt("[Benchmark] two ciphertexts: encrypt");
+    std::vector<PaillierPair> encrypted;
+    for (const ElementAndPayload& slot : slots) {
+        BigNum payload = slot.second;
+        if (!payload.IsNonNegative()) { payload = payload + sk.n(); }
+        ASSIGN_OR_RETURN(BigNum element, sk.Encrypt(slot.first));
+        ASSIGN_OR_RETURN(BigNum encrypted_payload, sk.Encrypt(payload));
+        encrypted.push_back(PaillierPair(element, encrypted_payload));
+    }
+    encrypt.stop();
+
+    TreeUpdates updates;
+    TreeNode* node = updates.add_nodes();
+    for (const PaillierPair& pair : encrypted) {
+        EncryptedElement* ee = node->add_elements();
+        *ee->mutable_deletion()->mutable_element() = pair.first.ToBytes();
+        *ee->mutable_deletion()->mutable_payload() = pair.second.ToBytes();
+    }
+
+    Timer combine("[Benchmark] two ciphertexts: combine path");
+    std::vector<BigNum> differences, products;
+    for (size_t i = 0; i < slots.size(); i++) {
+        BigNum alpha = ctx->GenerateRandLessThan(pk.n());
+        ASSIGN_OR_RETURN(BigNum alpha_minus_x, pk.Encrypt(alpha.ModSub(slots[i].first, pk.n())));
+        differences.push_back(pk.Add(alpha_minus_x, encrypted[i].first));
+        products.push_back(pk.Multiply(encrypted[i].second, value));
+    }
+    combine.stop();
+
+    Timer decrypt("[Benchmark] two ciphertexts: decrypt");
+    ASSIGN_OR_RETURN(std::vector<BigNum> decrypted, sk.DecryptBatch(differences));
+    decrypt.stop();
+
+    std::cout << "[Benchmark] two ciphertexts: TreeUpdates size "
+              << updates.ByteSizeLong() << " B" << std::endl;
+    return OkStatus();
+}
+
+/**
+ * packed layout: element and payload in one s = 2 ciphertext
+ */
+Status RunPackedPair(Context* ctx, const std::vector<ElementAndPayload>& slots) {
+    ASSIGN_OR_RETURN(auto keys, GeneratePaillierKeyPair(ctx, MODULUS_LENGTH, 2));
+    PublicPaillier pk(ctx, std::get<0>(keys));
+    PrivatePaillier sk(ctx, std::get<1>(keys));
+    PackedPaillierPair packed(ctx, &pk);
+    BigNum value = ctx->CreateBigNum(3);
+
+    Timer encrypt("[Benchmark] packed pair: encrypt");
+    std::vector<BigNum> encrypted;
+    for (const ElementAndPayload& slot : slots) {
+        ASSIGN_OR_RETURN(BigNum plaintext, packed.Encode(slot.first, slot.second));
+        ASSIGN_OR_RETURN(BigNum ciphertext, sk.Encrypt(plaintext));
+        encrypted.push_back(ciphertext);
+    }
+    encrypt.stop();
+
+    TreeUpdates updates;
+    TreeNode* node = updates.add_nodes();
+    for (const BigNum& ciphertext : encrypted) {
+        EncryptedElement* ee = node->add_elements();
+        *ee->mutable_only_paillier()->mutable_element() = ciphertext.ToBytes();
+    }
+
+    Timer combine("[Benchmark] packed pair: combine path");
+    std::vector<BigNum> differences, products;
+    for (size_t i = 0; i < slots.size(); i++) {
+        BigNum alpha = ctx->GenerateRandLessThan(pk.n());
+        ASSIGN_OR_RETURN(BigNum difference, packed.MaskedDifference(encrypted[i], slots[i].first, alpha));
+        differences.push_back(difference);
+        ASSIGN_OR_RETURN(BigNum product, packed.PayloadProduct(encrypted[i], slots[i].first, value));
+        products.push_back(product);
+    }
+    combine.stop();
+
+    Timer decrypt("[Benchmark] packed pair: decrypt");
+    ASSIGN_OR_RETURN(std::vector<BigNum> decrypted, sk.DecryptBatch(differences));
+    decrypt.stop();
+
+    std::cout << "[Benchmark] packed pair: TreeUpdates size "
+              << updates.ByteSizeLong() << " B" << std::endl;
+    return OkStatus();
+}
+
+int main(int argc, char** argv) {
+    std::cout << ">> PAILLIER PAIR LAYOUT (" << BENCHMARK_SIZE << " SLOTS) <<" << std::endl;
+
+    Context ctx;
+    std::vector<ElementAndPayload> slots;
+    for (int i = 0; i < BENCHMARK_SIZE; i++) {
+        BigNum element = ctx.CreateBigNum(ctx.GenerateRandomBytes(ELEMENT_STR_LENGTH));
+        BigNum payload = ctx.CreateBigNum(i % MAX_SUM);
+        if (i % 2 == 1) { payload = ctx.Zero() - payload; }
+        slots.push_back(std::make_pair(element, payload));
+    }
+
+    for (auto run : { RunTwoCiphertexts, RunPackedPair }) {
+        auto status = run(&ctx, slots);
+        if (!status.ok()) {
+            std::cerr << status << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
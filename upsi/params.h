@@ -25,9 +25,24 @@ struct PSIParams {
     // number of days to run protocol for
     int total_days;
 
+    // elliptic curve the el gamal keys and trees live on
+    int curve_id = CURVE_ID;
+
     // if creating mock trees, size of those trees
     int start_size = -1;
 
+    // paillier randomizers kept ready by a background thread (0 disables);
+    // about one day's worth of encryptions is enough to take them off the
+    // critical path, a larger pool only burns cpu between days
+    int paillier_pool = 0;
+
+    // addition: days of first messages prepared ahead (0 disables)
+    int pipeline_days = PIPELINE_DAYS;
+
+    // deletion: pack the garbled circuit outputs into shared paillier
+    // plaintexts instead of sending one ciphertext per candidate through OT
+    bool paillier_packing = true;
+
     // parameters for the CryptoTrees
     int stash_size = DEFAULT_STASH_SIZE;
     int node_size = DEFAULT_NODE_SIZE;
@@ -0,0 +1,73 @@
+#include "absl/status/status.h"
+
+#include "upsi/crypto/ec_group.h"
+#include "upsi/crypto/ec_point.h"
+#include "upsi/crypto/object_pool.h"
+#include "upsi/utils.h"
+
+using namespace upsi;
+
+// number of candidates pushed through each loop
+#define BENCHMARK_SIZE 20000
+
+/**
+ * mimics a candidate loop: every iteration creates and drops a handful of
+ * point and bignum temporaries, which is where the allocator pressure is
+ */
+Status RunCandidateLoop(const ECGroup& group, const std::string& name) {
+    Context* ctx = ContextPool::Get();
+    const BigNum& order = group.GetOrder();
+
+    ASSIGN_OR_RETURN(ECPoint g, group.GetFixedGenerator());
+    ASSIGN_OR_RETURN(ECPoint acc, group.GetPointAtInfinity());
+    BigNum scalar = group.GeneratePrivateKey();
+
+    Timer points("[Benchmark] " + name + " point temporaries");
+    for (auto i = 0; i < BENCHMARK_SIZE; i++) {
+        ASSIGN_OR_RETURN(ECPoint copy, g.Clone());
+        ASSIGN_OR_RETURN(ECPoint inverse, copy.Inverse());
+        ASSIGN_OR_RETURN(ECPoint sum, acc.Add(inverse));
+        ASSIGN_OR_RETURN(acc, sum.Add(g));
+    }
+    points.stop();
+
+    Timer bignums("[Benchmark] " + name + " bignum temporaries");
+    BigNum x = ctx->One();
+    for (auto i = 0; i < BENCHMARK_SIZE; i++) {
+        BigNum y = x.ModMul(scalar, order);
+        BigNum z = y.ModAdd(ctx->One(), order);
+        x = z.ModSub(y, order) + y;
+    }
+    bignums.stop();
+
+    Timer mul("[Benchmark] " + name + " scalar multiplication");
+    for (auto i = 0; i < BENCHMARK_SIZE / 10; i++) {
+        ASSIGN_OR_RETURN(ECPoint product, g.Mul(scalar));
+    }
+    mul.stop();
+
+    ObjectPool::Release();
+    return OkStatus();
+}
+
+int main(int argc, char** argv) {
+    std::cout << ">> OBJECT POOL (" << BENCHMARK_SIZE << " ITERATIONS) <<" << std::endl;
+
+    Context ctx;
+    auto group = ECGroup::Create(CURVE_ID, &ctx);
+    if (!group.ok()) {
+        std::cerr << group.status() << std::endl;
+        return 1;
+    }
+
+    for (bool enabled : { false, true }) {
+        ObjectPool::SetEnabled(enabled);
+        auto status = RunCandidateLoop(group.value(), enabled ? "pooled" : "malloc");
+        if (!status.ok()) {
+            std::cerr << status << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
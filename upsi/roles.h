@@ -7,6 +7,7 @@
 #include "upsi/network/message_sink.h"
 #include "upsi/params.h"
 #include "upsi/network/upsi.pb.h"
+#include "upsi/util/intersection_index.h"
 #include "upsi/util/proto_util.h"
 #include "upsi/util/status.inc"
 #include "upsi/utils.h"
@@ -71,13 +72,16 @@ class HasTree {
         CryptoTree<P> my_tree;
         CryptoTree<E> other_tree;
 
+        // maps g^x back to x for the elements of our tree (PSI only)
+        IntersectionIndex my_index;
+
         HasTree(PSIParams* params) :
             my_tree(params->stash_size, params->node_size),
             other_tree(params->stash_size, params->node_size)
         {
             this->ctx_ = params->ctx;
 
-            auto group = new ECGroup(ECGroup::Create(CURVE_ID, ctx_).value());
+            auto group = new ECGroup(ECGroup::Create(params->curve_id, ctx_).value());
             this->group = group;
 
             // if specified, load initial trees in from file
@@ -95,6 +99,11 @@ class HasTree {
                     std::cerr << load << std::endl;
                     throw std::runtime_error("[HasTree] error loading my tree");
                 }
+                load = this->my_index.Deserialize(plaintext.value().index());
+                if (!load.ok()) {
+                    std::cerr << load << std::endl;
+                    throw std::runtime_error("[HasTree] error loading my index");
+                }
 
                 auto encrypted = ProtoUtils::ReadProtoFromFile<EncryptedTree>(params->other_tree_fn);
                 if (!encrypted.ok()) {
@@ -0,0 +1,71 @@
+#include "absl/status/status.h"
+
+#include "upsi/crypto/threshold_paillier.h"
+#include "upsi/utils.h"
+
+using namespace upsi;
+
+// number of ciphertexts partially decrypted per variant
+#define BENCHMARK_SIZE 32
+
+// threshold paillier parameters, as in the tests
+#define MODULUS_LENGTH 1536
+#define STATISTICAL_PARAM 100
+
+/**
+ * partially decrypts the same ciphertexts with a plain BigNum::ModExp by the
+ * share, with PartialDecrypt and its cached Montgomery context, and with
+ * PartialDecryptBatch; all three must agree
+ */
+Status RunPartialDecrypt(Context* ctx) {
+    ASSIGN_OR_RETURN(
+        auto keys, GenerateThresholdPaillierKeys(ctx, MODULUS_LENGTH, STATISTICAL_PARAM)
+    );
+    ThresholdPaillier party(ctx, std::get<0>(keys));
+    BigNum share = ctx->CreateBigNum(std::get<0>(keys).share());
+    RETURN_IF_ERROR(party.PrecomputeRandomness(BENCHMARK_SIZE));
+
+    std::vector<BigNum> ciphertexts;
+    for (auto i = 0; i < BENCHMARK_SIZE; i++) {
+        ASSIGN_OR_RETURN(BigNum ciphertext, party.Encrypt(ctx->GenerateRandLessThan(party.n)));
+        ciphertexts.push_back(std::move(ciphertext));
+    }
+
+    Timer modexp("[Benchmark] BigNum::ModExp");
+    std::vector<BigNum> expected;
+    for (const BigNum& ciphertext : ciphertexts) {
+        expected.push_back(ciphertext.ModExp(share, party.n_squared_));
+    }
+    modexp.stop();
+
+    Timer single("[Benchmark] PartialDecrypt");
+    std::vector<BigNum> partials;
+    for (const BigNum& ciphertext : ciphertexts) {
+        ASSIGN_OR_RETURN(BigNum partial, party.PartialDecrypt(ciphertext));
+        partials.push_back(std::move(partial));
+    }
+    single.stop();
+
+    Timer batch("[Benchmark] PartialDecryptBatch");
+    ASSIGN_OR_RETURN(std::vector<BigNum> batched, party.PartialDecryptBatch(ciphertexts));
+    batch.stop();
+
+    if (partials != expected || batched != expected) {
+        return InternalError("[Benchmark] partial decryptions do not agree");
+    }
+    return OkStatus();
+}
+
+int main(int argc, char** argv) {
+    std::cout << ">> THRESHOLD PAILLIER PARTIAL DECRYPTION ("
+              << BENCHMARK_SIZE << " CIPHERTEXTS) <<" << std::endl;
+
+    Context ctx;
+    auto status = RunPartialDecrypt(&ctx);
+    if (!status.ok()) {
+        std::cerr << status << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
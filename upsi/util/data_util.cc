@@ -216,6 +216,27 @@ std::vector<Dataset> ReadDailyDatasets(Context* ctx, std::string dir, int days)
     return datasets;
 }
 
+std::vector<Dataset> MergeDailyDatasets(const std::vector<Dataset>& datasets, int batch_days) {
+    if (batch_days <= 1) { return datasets; }
+
+    std::vector<Dataset> batches;
+    for (size_t first = 0; first < datasets.size(); first += batch_days) {
+        Dataset batch = datasets[first];
+        size_t last = std::min(datasets.size(), first + batch_days);
+        for (size_t day = first + 1; day < last; day++) {
+            batch.elements.insert(
+                batch.elements.end(), datasets[day].elements.begin(), datasets[day].elements.end()
+            );
+            batch.values.insert(
+                batch.values.end(), datasets[day].values.begin(), datasets[day].values.end()
+            );
+        }
+        batches.push_back(std::move(batch));
+    }
+
+    return batches;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // MOCK ADDITION DATA HELPERS
 ////////////////////////////////////////////////////////////////////////////////
@@ -45,6 +45,12 @@ class Dataset {
 
 std::vector<Dataset> ReadDailyDatasets(Context* ctx, std::string dir, int days);
 
+/**
+ * merges every `batch_days` consecutive daily datasets into one (the last
+ * batch may be shorter), so that they are inserted in a single protocol round
+ */
+std::vector<Dataset> MergeDailyDatasets(const std::vector<Dataset>& datasets, int batch_days);
+
 std::tuple<
     Dataset, std::vector<Dataset>, Dataset, std::vector<Dataset>, int64_t
 > GenerateAddOnlySets(
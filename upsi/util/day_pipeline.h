@@ -0,0 +1,111 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "upsi/util/status.inc"
+
+namespace upsi {
+
+/**
+ * Runs the per-day work that only depends on a party's own data ahead of the
+ * protocol, on one background thread
+ *
+ * prepare(day) is called for every day in [first, last), strictly in order
+ * and never more than `window` days ahead of the day last taken with Next, so
+ * state that carries over from one day to the next (e.g. our own tree) is
+ * updated in the same order as without the pipeline. With a window of 0
+ * nothing runs in the background and Next calls prepare itself.
+ *
+ * prepare must not touch anything the protocol thread uses concurrently; in
+ * particular it may not read the other party's tree.
+ */
+template <typename T>
+class DayPipeline {
+    public:
+        DayPipeline(
+            int first, int last, size_t window, std::function<StatusOr<T>(int)> prepare
+        ) : next_day_(first), last_(last), window_(window), prepare_(std::move(prepare)) {
+            if (window_ > 0 && first < last) {
+                worker_ = std::thread([this]() { Work(); });
+            }
+        }
+
+        DayPipeline(const DayPipeline&) = delete;
+        DayPipeline& operator=(const DayPipeline&) = delete;
+
+        ~DayPipeline() {
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            if (worker_.joinable()) { worker_.join(); }
+        }
+
+        /**
+         * returns the result of the next day, waiting for it if needed
+         */
+        StatusOr<T> Next() {
+            if (!worker_.joinable()) {
+                if (next_day_ >= last_) {
+                    return InvalidArgumentError("[DayPipeline] no days left");
+                }
+                return prepare_(next_day_++);
+            }
+
+            std::unique_lock<std::mutex> lock(mu_);
+            cv_.wait(lock, [this]() { return !ready_.empty() || finished_; });
+            if (ready_.empty()) {
+                return InvalidArgumentError("[DayPipeline] no days left");
+            }
+            StatusOr<T> result = std::move(ready_.front());
+            ready_.pop_front();
+            lock.unlock();
+            cv_.notify_all();
+            return result;
+        }
+
+    private:
+        // body of the background thread
+        void Work() {
+            std::unique_lock<std::mutex> lock(mu_);
+            while (next_day_ < last_) {
+                cv_.wait(lock, [this]() { return ready_.size() < window_ || stop_; });
+                if (stop_) { break; }
+                int day = next_day_++;
+
+                lock.unlock();
+                StatusOr<T> result = prepare_(day);
+                lock.lock();
+
+                bool failed = !result.ok();
+                ready_.push_back(std::move(result));
+                cv_.notify_all();
+                // later days may depend on the failed one, so stop here
+                if (failed) { break; }
+            }
+            finished_ = true;
+            cv_.notify_all();
+        }
+
+        int next_day_;
+        const int last_;
+        const size_t window_;
+        const std::function<StatusOr<T>(int)> prepare_;
+
+        std::mutex mu_;
+        std::condition_variable cv_;
+        std::deque<StatusOr<T>> ready_;
+        bool finished_ = false;
+        bool stop_ = false;
+
+        // declared last so that everything it uses exists while it runs
+        std::thread worker_;
+};
+
+}  // namespace upsi
@@ -0,0 +1,65 @@
+#include "upsi/util/day_pipeline.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "upsi/util/status_testing.inc"
+
+namespace upsi {
+namespace {
+
+using ::testing::HasSubstr;
+using testing::IsOkAndHolds;
+using testing::StatusIs;
+
+/**
+ * days come out in order, both with and without a background thread, and
+ * the background thread never runs more than the window ahead
+ */
+TEST(DayPipelineTest, PreparesDaysInOrder) {
+    for (size_t window : { 0, 1, 3 }) {
+        std::atomic<int> taken{0};
+        std::atomic<int> max_ahead{0};
+        std::vector<int> prepared;
+
+        DayPipeline<int> pipeline(2, 10, window, [&](int day) -> StatusOr<int> {
+            prepared.push_back(day);
+            int ahead = day - 2 - taken.load();
+            if (ahead > max_ahead.load()) { max_ahead = ahead; }
+            return day * day;
+        });
+
+        for (int day = 2; day < 10; day++) {
+            ASSERT_OK_AND_ASSIGN(int result, pipeline.Next());
+            EXPECT_EQ(result, day * day);
+            taken++;
+        }
+        EXPECT_THAT(pipeline.Next(), StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("no days left")));
+
+        EXPECT_EQ(prepared, std::vector<int>({ 2, 3, 4, 5, 6, 7, 8, 9 }));
+        EXPECT_LE(max_ahead.load(), static_cast<int>(window));
+    }
+}
+
+/**
+ * a failed day is handed out in its turn and no later day is prepared
+ */
+TEST(DayPipelineTest, StopsAfterFailure) {
+    std::atomic<int> calls{0};
+    DayPipeline<int> pipeline(0, 10, 2, [&](int day) -> StatusOr<int> {
+        calls++;
+        if (day == 1) { return InternalError("day one failed"); }
+        return day;
+    });
+
+    EXPECT_THAT(pipeline.Next(), IsOkAndHolds(0));
+    EXPECT_THAT(pipeline.Next(), StatusIs(absl::StatusCode::kInternal, HasSubstr("day one")));
+    EXPECT_THAT(pipeline.Next(), StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("no days left")));
+    EXPECT_EQ(calls.load(), 2);
+}
+
+}  // namespace
+}  // namespace upsi
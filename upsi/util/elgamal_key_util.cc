@@ -43,6 +43,7 @@ Status GenerateElGamalKeyPair(int curve_id, absl::string_view pub_key_filename,
   ASSIGN_OR_RETURN(
       auto public_key_proto,
       elgamal_proto_util::SerializePublicKey(*key_pair.first.get()));
+  public_key_proto.set_curve_id(curve_id);
   ASSIGN_OR_RETURN(
       auto private_key_proto,
       elgamal_proto_util::SerializePrivateKey(*key_pair.second.get()));
@@ -77,8 +78,20 @@ Status ComputeJointElGamalPublicKey(
       upsi::elgamal::GeneratePublicKeyFromShares(shares));
   ASSIGN_OR_RETURN(auto joint_key_proto,
                    elgamal_proto_util::SerializePublicKey(*joint_key.get()));
+  joint_key_proto.set_curve_id(curve_id);
   RETURN_IF_ERROR(
       ProtoUtils::WriteProtoToFile(joint_key_proto, join_pub_key_key_filename));
   return OkStatus();
 }
+
+StatusOr<int> ReadCurveId(absl::string_view pub_key_filename) {
+  ASSIGN_OR_RETURN(
+      auto public_key_proto,
+      ProtoUtils::ReadProtoFromFile<ElGamalPublicKey>(pub_key_filename));
+  // keys written before the curve was recorded are all P-256
+  if (!public_key_proto.has_curve_id()) {
+    return NID_X9_62_prime256v1;
+  }
+  return public_key_proto.curve_id();
+}
 }  // namespace upsi::elgamal_key_util
@@ -38,6 +38,10 @@ Status ComputeJointElGamalPublicKey(
     int curve_id, const std::vector<std::string>& shares_filenames,
     absl::string_view join_pub_key_key_filename);
 
+// Returns the curve id recorded in the ::upsi::ElGamalPublicKey stored in
+// the given file. Keys that predate the curve_id field are P-256.
+StatusOr<int> ReadCurveId(absl::string_view pub_key_filename);
+
 }  // namespace upsi::elgamal_key_util
 
 #endif  // upsi_UTIL_ELGAMAL_KEY_UTIL_H_
@@ -119,6 +119,26 @@ TEST(ElGamalKeyUtilTest, ComputeJointElGamalPublicKey) {
   EXPECT_EQ(joint_public_key->y, expected_joint_public_key->y);
 }
 
+TEST(ElGamalKeyUtilTest, RecordsCurveId) {
+  const int kOtherCurveId = NID_secp384r1;
+  std::filesystem::path temp_dir(::testing::TempDir());
+  std::string pub_key_filename = (temp_dir / "elgamal_p384_pub.key").string();
+  std::string prv_key_filename = (temp_dir / "elgamal_p384_prv.key").string();
+  ASSERT_OK(GenerateElGamalKeyPair(kOtherCurveId, pub_key_filename,
+                                   prv_key_filename));
+  ASSERT_OK_AND_ASSIGN(int curve_id, ReadCurveId(pub_key_filename));
+  EXPECT_EQ(curve_id, kOtherCurveId);
+
+  // A key over one curve must not be loaded into a group over another.
+  Context context;
+  ASSERT_OK_AND_ASSIGN(auto ec_group, ECGroup::Create(kTestCurveId, &context));
+  ASSERT_OK_AND_ASSIGN(
+      auto public_key_proto,
+      ProtoUtils::ReadProtoFromFile<ElGamalPublicKey>(pub_key_filename));
+  EXPECT_TRUE(IsInvalidArgument(
+      DeserializePublicKey(&ec_group, public_key_proto).status()));
+}
+
 TEST(ElGamalKeyUtilTest, TestEmptyKeyShares) {
   std::vector<std::string> empty_key_shares;
   std::filesystem::path temp_dir(::testing::TempDir());
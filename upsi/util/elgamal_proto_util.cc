@@ -18,6 +18,8 @@
 #include <memory>
 #include <utility>
 
+#include "absl/strings/str_cat.h"
+
 namespace upsi::elgamal_proto_util {
 
 StatusOr<ElGamalPublicKey> SerializePublicKey(
@@ -49,6 +51,13 @@ StatusOr<ElGamalSecretKey> SerializePrivateKey(
 
 StatusOr<std::unique_ptr<elgamal::PublicKey>> DeserializePublicKey(
     const ECGroup* ec_group, const ElGamalPublicKey& public_key_proto) {
+  if (public_key_proto.has_curve_id() &&
+      public_key_proto.curve_id() != ec_group->GetCurveId()) {
+    return InvalidArgumentError(absl::StrCat(
+        "elgamal_proto_util::DeserializePublicKey() : key is over curve ",
+        public_key_proto.curve_id(), " but the group is curve ",
+        ec_group->GetCurveId()));
+  }
   ASSIGN_OR_RETURN(ECPoint public_key_struct_g,
                    ec_group->CreateECPoint(public_key_proto.g()));
   ASSIGN_OR_RETURN(ECPoint public_key_struct_y,
@@ -34,7 +34,8 @@ StatusOr<ElGamalPublicKey> SerializePublicKey(
     const elgamal::PublicKey& public_key_struct);
 
 // Converts a protocol buffer ElGamalPublicKey into a struct
-// elgamal::PublicKey. ec_group is used for ECPoint operations.
+// elgamal::PublicKey. ec_group is used for ECPoint operations. Fails if the
+// proto records a curve_id other than ec_group's.
 StatusOr<std::unique_ptr<elgamal::PublicKey>> DeserializePublicKey(
     const ECGroup* ec_group, const ElGamalPublicKey& public_key_proto);
 
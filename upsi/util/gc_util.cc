@@ -15,9 +15,7 @@ uint64_t bytes2uint64(const std::string& str) { //str: big-endian form
 }
 
 uint64_t generateRandom64bits() {
-    Context ctx;
-    std::string random_bytes = ctx.GenerateRandomBytes(8); // 32 bytes for SHA256 => obtain random_path as a byte string
-    return bytes2uint64(random_bytes);
+    return ContextPool::GetDrbg()->GenerateUint64();
 }
 
 uint64_t BigNum2uint64(const BigNum &x) {
@@ -39,10 +37,27 @@ void bytes2bool(const std::string& str, bool* bool_val, int cnt) {
 }
 
 void BigNum2bool(const BigNum &x, bool* bool_val, int cnt) {
-    Context ctx;
-    BigNum max_value = ctx.One() << (cnt + 1);
-    BigNum tmp = ctx.RandomOracleSha256(x.ToBytes(), max_value);
-    return bytes2bool(tmp.ToBytes(), bool_val, cnt);
+    Context* ctx = ContextPool::Get();
+    BigNum max_value = ctx->One() << (cnt + 1);
+    std::string bytes = ctx->RandomOracleSha256(x.ToBytes(), max_value).ToBytes();
+    // small outputs have fewer bytes than bytes2bool reads
+    PadBytes(bytes, (cnt + 7) >> 3);
+    return bytes2bool(bytes, bool_val, cnt);
+}
+
+void BigNum2bool(const std::vector<BigNum> &x, bool* bool_val, int cnt) {
+    Context* ctx = ContextPool::Get();
+    BigNum max_value = ctx->One() << (cnt + 1);
+    std::vector<std::string> inputs;
+    inputs.reserve(x.size());
+    for (const BigNum& elem : x) inputs.push_back(elem.ToBytes());
+
+    std::vector<BigNum> hashed = ctx->RandomOracleSha256Batch(inputs, max_value);
+    for (size_t i = 0; i < hashed.size(); ++i) {
+        std::string bytes = hashed[i].ToBytes();
+        PadBytes(bytes, (cnt + 7) >> 3);
+        bytes2bool(bytes, bool_val + i * cnt, cnt);
+    }
 }
 
 void BigNum2block(BigNum x, emp::block* bl, int cnt_block) {
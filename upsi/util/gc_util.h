@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "upsi/crypto/big_num.h"
 #include "upsi/crypto/context.h"
 #include "emp-sh2pc/emp-sh2pc.h"
@@ -14,6 +16,8 @@ uint64_t generateRandom64bits();
 uint64_t BigNum2uint64(const BigNum &x); // mod 2^64
 void bytes2bool(const std::string& str, bool* bool_val, int cnt = GC_SIZE);
 void BigNum2bool(const BigNum &x, bool* bool_val, int cnt = GC_SIZE);
+// BigNum2bool for every x[i], hashed as one batch; bool_val holds x.size() * cnt
+void BigNum2bool(const std::vector<BigNum> &x, bool* bool_val, int cnt = GC_SIZE);
 void BigNum2block(BigNum x, emp::block* bl, int cnt_block);
 BigNum block2BigNum(emp::block* bl, int cnt_block, Context* ctx);
 void PadBytes(std::string& str, int len);
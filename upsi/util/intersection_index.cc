@@ -0,0 +1,123 @@
+#include "upsi/util/intersection_index.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace upsi {
+
+namespace {
+
+// the table grows once it is more than 3/4 full
+constexpr size_t MAX_LOAD_NUMERATOR = 3;
+constexpr size_t MAX_LOAD_DENOMINATOR = 4;
+
+constexpr size_t MIN_CAPACITY = 16;
+
+/**
+ * fingerprint 0 marks an empty slot, so it is stored as 1 instead
+ */
+uint64_t Normalize(uint64_t fingerprint) {
+    return fingerprint == 0 ? 1 : fingerprint;
+}
+
+/**
+ * the fingerprints are already uniform, this only spreads runs of nearby
+ * values (e.g. in tests) over the table
+ */
+size_t SlotOf(uint64_t fingerprint, size_t mask) {
+    uint64_t mixed = fingerprint * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(mixed ^ (mixed >> 32)) & mask;
+}
+
+}  // namespace
+
+StatusOr<uint64_t> IntersectionIndex::Fingerprint(const ECPoint& point) {
+    // the compressed encoding ends with the big-endian x-coordinate
+    ASSIGN_OR_RETURN(std::string bytes, point.ToBytesCompressed());
+    uint64_t fingerprint = 0;
+    size_t start = bytes.size() > 8 ? bytes.size() - 8 : 0;
+    for (size_t i = start; i < bytes.size(); i++) {
+        fingerprint = (fingerprint << 8) | static_cast<uint8_t>(bytes[i]);
+    }
+    return fingerprint;
+}
+
+void IntersectionIndex::Insert(uint64_t fingerprint, uint64_t id) {
+    fingerprint = Normalize(fingerprint);
+    if ((size_ + 1) * MAX_LOAD_DENOMINATOR > slots_.size() * MAX_LOAD_NUMERATOR) {
+        Rehash(std::max(slots_.size() * 2, MIN_CAPACITY));
+    }
+
+    size_t mask = slots_.size() - 1;
+    for (size_t i = SlotOf(fingerprint, mask); ; i = (i + 1) & mask) {
+        if (slots_[i].fingerprint == 0) {
+            slots_[i] = { fingerprint, id };
+            size_++;
+            return;
+        } else if (slots_[i].fingerprint == fingerprint) {
+            slots_[i].id = id;
+            return;
+        }
+    }
+}
+
+std::optional<uint64_t> IntersectionIndex::Find(uint64_t fingerprint) const {
+    if (slots_.empty()) { return std::nullopt; }
+    fingerprint = Normalize(fingerprint);
+
+    size_t mask = slots_.size() - 1;
+    for (size_t i = SlotOf(fingerprint, mask); ; i = (i + 1) & mask) {
+        if (slots_[i].fingerprint == 0) {
+            return std::nullopt;
+        } else if (slots_[i].fingerprint == fingerprint) {
+            return slots_[i].id;
+        }
+    }
+}
+
+void IntersectionIndex::Reserve(size_t count) {
+    size_t capacity = std::max(slots_.size(), MIN_CAPACITY);
+    while (count * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR) {
+        capacity *= 2;
+    }
+    if (capacity > slots_.size()) { Rehash(capacity); }
+}
+
+void IntersectionIndex::Rehash(size_t capacity) {
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(capacity, Slot());
+
+    size_t mask = capacity - 1;
+    for (const Slot& slot : old) {
+        if (slot.fingerprint == 0) { continue; }
+        size_t i = SlotOf(slot.fingerprint, mask);
+        while (slots_[i].fingerprint != 0) { i = (i + 1) & mask; }
+        slots_[i] = slot;
+    }
+}
+
+void IntersectionIndex::Serialize(IntersectionEntries* entries) const {
+    entries->mutable_fingerprints()->Reserve(size_);
+    entries->mutable_ids()->Reserve(size_);
+    for (const Slot& slot : slots_) {
+        if (slot.fingerprint == 0) { continue; }
+        entries->add_fingerprints(slot.fingerprint);
+        entries->add_ids(slot.id);
+    }
+}
+
+Status IntersectionIndex::Deserialize(const IntersectionEntries& entries) {
+    if (entries.fingerprints_size() != entries.ids_size()) {
+        return InvalidArgumentError(
+            "[IntersectionIndex] number of fingerprints and ids differ"
+        );
+    }
+    Reserve(size_ + entries.fingerprints_size());
+    for (int i = 0; i < entries.fingerprints_size(); i++) {
+        Insert(entries.fingerprints(i), entries.ids(i));
+    }
+    return OkStatus();
+}
+
+}  // namespace upsi
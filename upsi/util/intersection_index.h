@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "upsi/crypto/ec_point.h"
+#include "upsi/network/upsi.pb.h"
+#include "upsi/util/status.inc"
+
+namespace upsi {
+
+/**
+ * maps group elements (e.g. g^x) back to the element x they were computed
+ * from, to report the intersection
+ *
+ * only a 64-bit fingerprint of each point and a 64-bit element id are kept,
+ * in one open-addressing table with linear probing, i.e. 16 bytes per slot
+ * rather than a 65-byte point encoding and a decimal string per node of a
+ * std::map. Two stored points share a fingerprint with probability about
+ * n^2 / 2^65, in which case the later one wins.
+ */
+class IntersectionIndex {
+    public:
+        IntersectionIndex() = default;
+
+        /**
+         * the low 64 bits of the point's x-coordinate
+         */
+        static StatusOr<uint64_t> Fingerprint(const ECPoint& point);
+
+        /**
+         * maps the fingerprint to id, replacing any id it had before
+         */
+        void Insert(uint64_t fingerprint, uint64_t id);
+
+        /**
+         * returns the id stored for the fingerprint, if any
+         */
+        std::optional<uint64_t> Find(uint64_t fingerprint) const;
+
+        /**
+         * makes room for count entries in total without growing in between
+         */
+        void Reserve(size_t count);
+
+        size_t size() const { return size_; }
+
+        void Serialize(IntersectionEntries* entries) const;
+
+        /**
+         * adds the serialized entries to the index
+         */
+        Status Deserialize(const IntersectionEntries& entries);
+
+    private:
+        struct Slot {
+            // 0 marks an empty slot
+            uint64_t fingerprint = 0;
+            uint64_t id = 0;
+        };
+
+        // rebuilds the table with the given number of slots (a power of two)
+        void Rehash(size_t capacity);
+
+        std::vector<Slot> slots_;
+        size_t size_ = 0;
+};
+
+}  // namespace upsi
@@ -0,0 +1,97 @@
+#include "upsi/util/intersection_index.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "upsi/crypto/context.h"
+#include "upsi/crypto/ec_group.h"
+#include "upsi/util/status_testing.inc"
+
+namespace upsi {
+namespace {
+
+using ::testing::HasSubstr;
+using testing::StatusIs;
+
+/**
+ * every inserted fingerprint is found across several rehashes, inserting
+ * again replaces the id, and absent fingerprints (including 0) are not found
+ */
+TEST(IntersectionIndexTest, InsertAndFind) {
+    IntersectionIndex index;
+    EXPECT_FALSE(index.Find(42).has_value());
+
+    for (uint64_t i = 1; i <= 1000; i++) {
+        index.Insert(i * 7919, i);
+    }
+    EXPECT_EQ(index.size(), 1000u);
+    for (uint64_t i = 1; i <= 1000; i++) {
+        EXPECT_EQ(index.Find(i * 7919), i);
+    }
+    EXPECT_FALSE(index.Find(0).has_value());
+    EXPECT_FALSE(index.Find(7919 * 1001).has_value());
+
+    index.Insert(7919, 5);
+    EXPECT_EQ(index.size(), 1000u);
+    EXPECT_EQ(index.Find(7919), 5u);
+}
+
+/**
+ * a serialized index holds the same entries, and mismatched entries are
+ * rejected
+ */
+TEST(IntersectionIndexTest, SerializeDeserialize) {
+    IntersectionIndex index;
+    for (uint64_t i = 0; i < 100; i++) {
+        index.Insert(i << 40, i);
+    }
+
+    IntersectionEntries entries;
+    index.Serialize(&entries);
+    EXPECT_EQ(entries.fingerprints_size(), 100);
+
+    IntersectionIndex loaded;
+    ASSERT_OK(loaded.Deserialize(entries));
+    EXPECT_EQ(loaded.size(), 100u);
+    for (uint64_t i = 0; i < 100; i++) {
+        EXPECT_EQ(loaded.Find(i << 40), i);
+    }
+
+    entries.add_ids(0);
+    EXPECT_THAT(
+        loaded.Deserialize(entries),
+        StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("differ"))
+    );
+}
+
+/**
+ * points map back to the element they were computed from
+ */
+TEST(IntersectionIndexTest, LooksUpPoints) {
+    Context ctx;
+    ASSERT_OK_AND_ASSIGN(ECGroup group, ECGroup::Create(NID_X9_62_prime256v1, &ctx));
+    ASSERT_OK_AND_ASSIGN(ECPoint g, group.GetFixedGenerator());
+
+    IntersectionIndex index;
+    for (uint64_t x = 1; x <= 50; x++) {
+        ASSERT_OK_AND_ASSIGN(ECPoint point, g.Mul(ctx.CreateBigNum(x)));
+        ASSERT_OK_AND_ASSIGN(uint64_t fingerprint, IntersectionIndex::Fingerprint(point));
+        index.Insert(fingerprint, x);
+    }
+
+    for (uint64_t x = 1; x <= 60; x++) {
+        ASSERT_OK_AND_ASSIGN(ECPoint point, g.Mul(ctx.CreateBigNum(x)));
+        ASSERT_OK_AND_ASSIGN(uint64_t fingerprint, IntersectionIndex::Fingerprint(point));
+        if (x <= 50) {
+            EXPECT_EQ(index.Find(fingerprint), x);
+        } else {
+            EXPECT_FALSE(index.Find(fingerprint).has_value());
+        }
+    }
+}
+
+}  // namespace
+}  // namespace upsi
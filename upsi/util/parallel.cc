@@ -0,0 +1,52 @@
+#include "upsi/util/parallel.h"
+
+#include <utility>
+
+namespace upsi {
+
+namespace {
+
+thread_local bool in_worker = false;
+
+}  // namespace
+
+WorkerPool& WorkerPool::Get() {
+    // never destroyed: the threads live as long as the process
+    static WorkerPool* pool = new WorkerPool(NumWorkers() - 1);
+    return *pool;
+}
+
+bool WorkerPool::InWorker() {
+    return in_worker;
+}
+
+WorkerPool::WorkerPool(size_t threads) {
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        threads_.emplace_back([this]() { Work(); });
+    }
+}
+
+void WorkerPool::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void WorkerPool::Work() {
+    in_worker = true;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            cv_.wait(lock, [this]() { return !tasks_.empty(); });
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+}  // namespace upsi
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "upsi/util/status.inc"
+
+namespace upsi {
+
+/**
+ * Number of worker threads ParallelFor will use at most
+ */
+inline size_t NumWorkers() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+/**
+ * The threads ParallelFor hands its chunks to
+ *
+ * Created on first use with NumWorkers() - 1 threads (the calling thread
+ * runs a chunk itself) and kept for the rest of the process, so that the
+ * per-thread state the workers build up (ContextPool, ObjectPool lists) is
+ * reused across calls rather than rebuilt for every one.
+ */
+class WorkerPool {
+    public:
+        static WorkerPool& Get();
+
+        /**
+         * true on the pool's own threads
+         */
+        static bool InWorker();
+
+        /**
+         * queues the task to run on one of the threads
+         */
+        void Submit(std::function<void()> task);
+
+        size_t size() const { return threads_.size(); }
+
+    private:
+        explicit WorkerPool(size_t threads);
+
+        // body of every thread
+        void Work();
+
+        std::mutex mu_;
+        std::condition_variable cv_;
+        std::deque<std::function<void()>> tasks_;
+        std::vector<std::thread> threads_;
+};
+
+/**
+ * Splits [0, n) into at most NumWorkers() contiguous chunks of at least
+ * min_chunk indices and runs fn(begin, end) on each chunk, the first one on
+ * the calling thread and the others on the WorkerPool
+ *
+ * If there is only one chunk, or ParallelFor is called from a pool thread,
+ * everything runs on the calling thread. Crypto objects may be shared by the
+ * workers since each thread draws its scratch space from ContextPool.
+ * Returns the first non-OK status reported by a chunk.
+ */
+inline Status ParallelFor(
+    size_t n, size_t min_chunk, const std::function<Status(size_t, size_t)>& fn
+) {
+    size_t chunks = std::min(NumWorkers(), n / std::max<size_t>(min_chunk, 1));
+    if (chunks <= 1 || WorkerPool::InWorker()) { return fn(0, n); }
+
+    // rounding step up can leave the last chunks with nothing to do (17
+    // indices in 8 chunks of 3 only need 6), so drop those
+    size_t step = (n + chunks - 1) / chunks;
+    chunks = (n + step - 1) / step;
+    std::vector<Status> statuses(chunks);
+
+    std::mutex mu;
+    std::condition_variable done;
+    size_t pending = chunks - 1;
+    for (size_t c = 1; c < chunks; c++) {
+        size_t begin = c * step;
+        size_t end = std::min(n, begin + step);
+        WorkerPool::Get().Submit([&, c, begin, end]() {
+            statuses[c] = fn(begin, end);
+            // notify while holding the lock: the caller may return (and
+            // destroy mu and done) as soon as it is released
+            std::lock_guard<std::mutex> lock(mu);
+            if (--pending == 0) { done.notify_one(); }
+        });
+    }
+    statuses[0] = fn(0, std::min(n, step));
+
+    std::unique_lock<std::mutex> lock(mu);
+    done.wait(lock, [&pending]() { return pending == 0; });
+
+    for (const Status& status : statuses) {
+        RETURN_IF_ERROR(status);
+    }
+    return OkStatus();
+}
+
+}  // namespace upsi
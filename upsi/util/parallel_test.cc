@@ -0,0 +1,99 @@
+#include "upsi/util/parallel.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "upsi/util/status_testing.inc"
+
+namespace upsi {
+namespace {
+
+using ::testing::HasSubstr;
+using testing::StatusIs;
+
+/**
+ * every index is visited exactly once, also from nested calls
+ */
+TEST(ParallelForTest, VisitsEveryIndexOnce) {
+    std::vector<std::atomic<int>> visits(1000);
+    ASSERT_OK(ParallelFor(visits.size(), 1, [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+            visits[i]++;
+        }
+        // a nested call runs on the calling thread
+        return ParallelFor(end - begin, 1, [](size_t, size_t) { return OkStatus(); });
+    }));
+    for (const auto& count : visits) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+/**
+ * every chunk is non-empty, also when n does not divide evenly between the
+ * workers, and together the chunks cover [0, n)
+ */
+TEST(ParallelForTest, ChunksAreNonEmpty) {
+    for (size_t n = 1; n <= 100; n++) {
+        std::mutex mu;
+        std::vector<std::pair<size_t, size_t>> ranges;
+        ASSERT_OK(ParallelFor(n, 1, [&](size_t begin, size_t end) -> Status {
+            std::lock_guard<std::mutex> lock(mu);
+            ranges.emplace_back(begin, end);
+            return OkStatus();
+        }));
+
+        std::sort(ranges.begin(), ranges.end());
+        size_t next = 0;
+        for (const auto& range : ranges) {
+            EXPECT_LT(range.first, range.second) << "n = " << n;
+            EXPECT_EQ(range.first, next) << "n = " << n;
+            next = range.second;
+        }
+        EXPECT_EQ(next, n);
+    }
+}
+
+/**
+ * a failing chunk is reported once all chunks are done
+ */
+TEST(ParallelForTest, ReturnsFailure) {
+    std::atomic<size_t> done{0};
+    Status status = ParallelFor(100, 1, [&](size_t begin, size_t end) -> Status {
+        done += end - begin;
+        if (begin <= 50 && 50 < end) { return InvalidArgumentError("chunk failed"); }
+        return OkStatus();
+    });
+    EXPECT_THAT(status, StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("chunk failed")));
+    EXPECT_EQ(done.load(), 100u);
+}
+
+// counts how often a thread had to build its per-thread state
+std::atomic<int> thread_states{0};
+
+struct ThreadState {
+    ThreadState() { thread_states++; }
+};
+
+/**
+ * every call runs on the same pool threads, so per-thread state is built at
+ * most once per thread rather than once per call (a call need not reach
+ * every thread, so later calls may still build some)
+ */
+TEST(ParallelForTest, ReusesThreadState) {
+    for (int i = 0; i < 10; i++) {
+        ASSERT_OK(ParallelFor(NumWorkers() * 4, 1, [](size_t, size_t) -> Status {
+            thread_local ThreadState state;
+            return OkStatus();
+        }));
+    }
+    EXPECT_LE(thread_states.load(), (int) WorkerPool::Get().size() + 1);
+}
+
+}  // namespace
+}  // namespace upsi
@@ -5,43 +5,65 @@
 
 #include "absl/status/status.h"
 #include "upsi/crypto/paillier.pb.h"
+#include "upsi/crypto/safe_prime.h"
 #include "upsi/crypto/threshold_paillier.h"
 #include "upsi/crypto_tree.h"
 #include "upsi/util/data_util.h"
 #include "upsi/util/elgamal_key_util.h"
 #include "upsi/util/elgamal_proto_util.h"
+#include "upsi/util/intersection_index.h"
 #include "upsi/util/proto_util.h"
 #include "upsi/util/status.inc"
 #include "upsi/utils.h"
 
 namespace upsi {
 
+namespace {
+
+/**
+ * returns `count` safe primes for a modulus of `mod_length` bits, either from
+ * the cache file at `prime_cache` or from one parallel search
+ */
+StatusOr<std::vector<BigNum>> PaillierPrimes(
+    int32_t mod_length, size_t count, const std::string& prime_cache
+) {
+    if (prime_cache.empty()) {
+        return GenerateSafePrimes(mod_length / 2, count);
+    }
+    SafePrimeCache cache(prime_cache);
+    return cache.Take(mod_length / 2, count);
+}
+
+}  // namespace
+
 Status GenerateThresholdKeys(
     Context* ctx,
     std::string p0_dir,
     std::string p1_dir,
     int32_t mod_length,
-    int32_t stat_param
+    int32_t stat_param,
+    int curve_id,
+    const std::string& prime_cache
 ) {
     std::cout << "[Setup] generating keys" << std::flush;
 
     RETURN_IF_ERROR(
         elgamal_key_util::GenerateElGamalKeyPair(
-            CURVE_ID, p0_dir + "/elgamal.pub", p0_dir + "/elgamal.key"
+            curve_id, p0_dir + "/elgamal.pub", p0_dir + "/elgamal.key"
         )
     );
     std::cout << "." << std::flush;
 
     RETURN_IF_ERROR(
         elgamal_key_util::GenerateElGamalKeyPair(
-            CURVE_ID, p1_dir + "/elgamal.pub", p1_dir + "/elgamal.key"
+            curve_id, p1_dir + "/elgamal.pub", p1_dir + "/elgamal.key"
         )
     );
     std::cout << "." << std::flush;
 
     RETURN_IF_ERROR(
         elgamal_key_util::ComputeJointElGamalPublicKey(
-            CURVE_ID,
+            curve_id,
             { p0_dir + "elgamal.pub", p1_dir + "elgamal.pub" },
             p0_dir + "shared.pub"
         )
@@ -52,18 +74,20 @@ Status GenerateThresholdKeys(
     // easy file copy method before C++17
     RETURN_IF_ERROR(
         elgamal_key_util::ComputeJointElGamalPublicKey(
-            CURVE_ID,
+            curve_id,
             { p0_dir + "elgamal.pub", p1_dir + "elgamal.pub" },
             p1_dir + "shared.pub"
         )
     );
     std::cout << "." << std::flush;
 
-    RETURN_IF_ERROR(
-        GenerateThresholdPaillierKeys(
-            ctx, mod_length, stat_param, p0_dir + "paillier.key", p1_dir + "paillier.key"
-        )
+    ASSIGN_OR_RETURN(auto primes, PaillierPrimes(mod_length, 2, prime_cache));
+    ASSIGN_OR_RETURN(
+        auto paillier,
+        GenerateThresholdPaillierKeys(ctx, primes[0], primes[1], stat_param)
     );
+    RETURN_IF_ERROR(ProtoUtils::WriteProtoToFile(paillier.first, p0_dir + "paillier.key"));
+    RETURN_IF_ERROR(ProtoUtils::WriteProtoToFile(paillier.second, p1_dir + "paillier.key"));
     std::cout << "." << std::flush;
 
     // a bit of visual flare
@@ -87,13 +111,16 @@ Status GeneratePaillierKeys(
     std::string p0_dir,
     std::string p1_dir,
     int32_t mod_length,
-    int32_t stat_param
+    int32_t stat_param,
+    const std::string& prime_cache
 ) {
     std::cout << "[Setup] generating keys" << std::flush;
 
-    ASSIGN_OR_RETURN(auto p0, GeneratePaillierKeyPair(ctx, mod_length, 1));
+    // all four primes come out of a single search across every core
+    ASSIGN_OR_RETURN(auto primes, PaillierPrimes(mod_length, 4, prime_cache));
+    ASSIGN_OR_RETURN(auto p0, GeneratePaillierKeyPair(primes[0], primes[1], 1));
     std::cout << "." << std::flush;
-    ASSIGN_OR_RETURN(auto p1, GeneratePaillierKeyPair(ctx, mod_length, 1));
+    ASSIGN_OR_RETURN(auto p1, GeneratePaillierKeyPair(primes[2], primes[3], 1));
     std::cout << "." << std::flush;
 
     RETURN_IF_ERROR(
@@ -129,20 +156,21 @@ Status GeneratePaillierKeys(
 Status GenerateElGamalKeys(
     Context* ctx,
     std::string p0_dir,
-    std::string p1_dir
+    std::string p1_dir,
+    int curve_id
 ) {
     std::cout << "[Setup] generating keys" << std::flush;
 
     RETURN_IF_ERROR(
         elgamal_key_util::GenerateElGamalKeyPair(
-            CURVE_ID, p0_dir + "/elgamal.pub", p0_dir + "/elgamal.key"
+            curve_id, p0_dir + "/elgamal.pub", p0_dir + "/elgamal.key"
         )
     );
     std::cout << "." << std::flush;
 
     RETURN_IF_ERROR(
         elgamal_key_util::GenerateElGamalKeyPair(
-            CURVE_ID, p1_dir + "/elgamal.pub", p1_dir + "/elgamal.key"
+            curve_id, p1_dir + "/elgamal.pub", p1_dir + "/elgamal.key"
         )
     );
     std::cout << "." << std::flush;
@@ -182,16 +210,23 @@ Status WriteTrees(
     CryptoTree<P>& plaintext,
     const std::string& plaintext_dir,
     CryptoTree<E>& encrypted,
-    const std::string& encrypted_dir
+    const std::string& encrypted_dir,
+    int curve_id,
+    const IntersectionIndex* index = nullptr
 ) {
     PlaintextTree ptree;
     RETURN_IF_ERROR(plaintext.Serialize(&ptree));
+    ptree.set_curve_id(curve_id);
+    if (index != nullptr) {
+        index->Serialize(ptree.mutable_index());
+    }
     RETURN_IF_ERROR(
         ProtoUtils::WriteProtoToFile(ptree, plaintext_dir + "plaintext.tree")
     );
 
     EncryptedTree etree;
     RETURN_IF_ERROR(encrypted.Serialize(&etree));
+    etree.set_curve_id(curve_id);
     RETURN_IF_ERROR(
         ProtoUtils::WriteProtoToFile(etree, encrypted_dir + "encrypted.tree")
     );
@@ -219,7 +254,9 @@ Status GenerateTrees(
     RETURN_IF_ERROR(encrypted.Update(ctx, group, &updates));
 
     // write them to disk
-    RETURN_IF_ERROR(WriteTrees(plaintext, plaintext_dir, encrypted, encrypted_dir));
+    RETURN_IF_ERROR(
+        WriteTrees(plaintext, plaintext_dir, encrypted, encrypted_dir, group->GetCurveId())
+    );
     return OkStatus();
 }
 
@@ -249,7 +286,9 @@ Status GenerateTrees(
         RETURN_IF_ERROR(plaintext.Update(ctx, elgamal.get(), &paillier, data, &updates));
         RETURN_IF_ERROR(encrypted.Update(ctx, group, &updates));
 
-        RETURN_IF_ERROR(WriteTrees(plaintext, plaintext_dir, encrypted, encrypted_dir));
+        RETURN_IF_ERROR(
+            WriteTrees(plaintext, plaintext_dir, encrypted, encrypted_dir, group->GetCurveId())
+        );
     } else {
         ASSIGN_OR_RETURN(auto elgamal, GetElGamal(key_dir, group));
 
@@ -260,7 +299,23 @@ Status GenerateTrees(
         RETURN_IF_ERROR(plaintext.Update(ctx, elgamal.get(), data, &updates));
         RETURN_IF_ERROR(encrypted.Update(ctx, group, &updates));
 
-        RETURN_IF_ERROR(WriteTrees(plaintext, plaintext_dir, encrypted, encrypted_dir));
+        // for PSI the intersection lookup (g^x to x) is stored with the tree
+        IntersectionIndex index;
+        if (func == Functionality::PSI) {
+            index.Reserve(data.size());
+            for (const ElementAndPayload& element : data) {
+                ASSIGN_OR_RETURN(ECPoint point, elgamal->getPublicKey()->g.Mul(element.first));
+                ASSIGN_OR_RETURN(uint64_t fingerprint, IntersectionIndex::Fingerprint(point));
+                ASSIGN_OR_RETURN(uint64_t id, element.first.ToIntValue());
+                index.Insert(fingerprint, id);
+            }
+        }
+
+        RETURN_IF_ERROR(
+            WriteTrees(
+                plaintext, plaintext_dir, encrypted, encrypted_dir, group->GetCurveId(), &index
+            )
+        );
     }
     return OkStatus();
 }
@@ -289,7 +344,9 @@ Status GenerateTrees(
     RETURN_IF_ERROR(plaintext.Update(ctx, &paillier, daily, &updates));
     RETURN_IF_ERROR(encrypted.Update(ctx, group, &updates));
 
-    RETURN_IF_ERROR(WriteTrees(plaintext, plaintext_dir, encrypted, encrypted_dir));
+    RETURN_IF_ERROR(
+        WriteTrees(plaintext, plaintext_dir, encrypted, encrypted_dir, group->GetCurveId())
+    );
 
     return OkStatus();
 }
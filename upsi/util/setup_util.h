@@ -7,29 +7,35 @@
 
 namespace upsi {
 
-// create threshold El Gamal and Paillier public and private keys
+// create threshold El Gamal (over the given curve) and Paillier public and
+// private keys; if `prime_cache` names a file, the Paillier primes are taken
+// from (and added to) that SafePrimeCache instead of being generated fresh
 Status GenerateThresholdKeys(
     Context* ctx,
     std::string p0_dir,
     std::string p1_dir,
     int32_t mod_length,
-    int32_t stat_param
+    int32_t stat_param,
+    int curve_id = CURVE_ID,
+    const std::string& prime_cache = ""
 );
 
-// create Paillier public and private keys
+// create Paillier public and private keys, with `prime_cache` as above
 Status GeneratePaillierKeys(
     Context* ctx,
     std::string p0_dir,
     std::string p1_dir,
     int32_t mod_length,
-    int32_t stat_param
+    int32_t stat_param,
+    const std::string& prime_cache = ""
 );
 
-// create El Gamal public and private keys
+// create El Gamal public and private keys over the given curve
 Status GenerateElGamalKeys(
     Context* ctx,
     std::string p0_dir,
-    std::string p1_dir
+    std::string p1_dir,
+    int curve_id = CURVE_ID
 );
 
 // create plaintext and encrypted trees with the given data
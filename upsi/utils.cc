@@ -1,10 +1,14 @@
 #include "utils.h"
 
 #include <chrono>
+#include <functional>
 #include <iomanip>
+#include <optional>
 
+#include "absl/strings/str_cat.h"
 #include "upsi/network/upsi.pb.h"
 #include "upsi/util/elgamal_proto_util.h"
+#include "upsi/util/parallel.h"
 
 
 namespace upsi {
@@ -40,51 +44,109 @@ std::string AbslUnparseFlag(Functionality func) {
     }
 }
 
+namespace {
+    const std::vector<std::pair<std::string, int>> kCurveNames = {
+        { "P-224", NID_secp224r1 },
+        { "P-256", NID_X9_62_prime256v1 },
+        { "P-384", NID_secp384r1 },
+        { "P-521", NID_secp521r1 },
+        { "secp256k1", NID_secp256k1 },
+    };
+}
+
+StatusOr<int> CurveIdFromName(absl::string_view name) {
+    for (const auto& [curve_name, curve_id] : kCurveNames) {
+        if (name == curve_name) { return curve_id; }
+    }
+    return InvalidArgumentError(absl::StrCat("unknown curve: ", name));
+}
+
+std::string CurveName(int curve_id) {
+    for (const auto& [curve_name, id] : kCurveNames) {
+        if (id == curve_id) { return curve_name; }
+    }
+    return absl::StrCat("curve ", curve_id);
+}
+
+namespace {
+
+// smallest number of ciphertexts worth handing to a worker thread
+constexpr size_t MIN_CIPHERTEXT_CHUNK = 16;
+
+/**
+ * deserializes the n ciphertexts ciphertext(0), ..., ciphertext(n - 1),
+ * decompressing their points across worker threads
+ */
+StatusOr<std::vector<Ciphertext>> DecodeCiphertexts(
+    ECGroup* group, size_t n, const std::function<const ElGamalCiphertext&(size_t)>& ciphertext
+) {
+    std::vector<std::optional<Ciphertext>> decoded(n);
+    RETURN_IF_ERROR(ParallelFor(n, MIN_CIPHERTEXT_CHUNK, [&](size_t begin, size_t end) -> Status {
+        for (size_t i = begin; i < end; i++) {
+            ASSIGN_OR_RETURN(
+                Ciphertext result,
+                elgamal_proto_util::DeserializeCiphertext(group, ciphertext(i))
+            );
+            decoded[i].emplace(std::move(result));
+        }
+        return OkStatus();
+    }));
+
+    std::vector<Ciphertext> ciphertexts;
+    ciphertexts.reserve(n);
+    for (std::optional<Ciphertext>& result : decoded) {
+        ciphertexts.push_back(std::move(*result));
+    }
+    return ciphertexts;
+}
+
+}  // namespace
+
 template<>
 StatusOr<std::vector<Ciphertext>> DeserializeCiphertexts(
-    const google::protobuf::RepeatedPtrField<EncryptedElement> serialized,
+    const google::protobuf::RepeatedPtrField<EncryptedElement>& serialized,
     Context* ctx,
     ECGroup* group
 ) {
-    std::vector<Ciphertext> ciphertexts;
     for (const EncryptedElement& element : serialized) {
         if (!element.has_no_payload()) {
             return InvalidArgumentError(
                 "[Utils] attempting to parse message with a payload"
             );
         }
-        ASSIGN_OR_RETURN(
-            Ciphertext ciphertext,
-            elgamal_proto_util::DeserializeCiphertext(group, element.no_payload().element())
-        );
-        ciphertexts.push_back(std::move(ciphertext));
     }
-    return ciphertexts;
+    return DecodeCiphertexts(group, serialized.size(), [&](size_t i) -> const ElGamalCiphertext& {
+        return serialized[i].no_payload().element();
+    });
 }
 
 template<>
 StatusOr<std::vector<CiphertextAndElGamal>> DeserializeCiphertexts(
-    const google::protobuf::RepeatedPtrField<EncryptedElement> serialized,
+    const google::protobuf::RepeatedPtrField<EncryptedElement>& serialized,
     Context* ctx,
     ECGroup* group
 ) {
-    std::vector<std::pair<Ciphertext, Ciphertext>> ciphertexts;
     for (const EncryptedElement& element : serialized) {
         if (!element.has_elgamal()) {
             return InvalidArgumentError(
                 "[Utils] attempting to parse message without El Gamal payload"
             );
         }
-        ASSIGN_OR_RETURN(
-            Ciphertext ciphertext,
-            elgamal_proto_util::DeserializeCiphertext(group, element.elgamal().element())
-        );
-        ASSIGN_OR_RETURN(
-            Ciphertext payload,
-            elgamal_proto_util::DeserializeCiphertext(group, element.elgamal().payload())
-        );
+    }
+    // element and payload of entry i are at 2i and 2i + 1
+    ASSIGN_OR_RETURN(
+        std::vector<Ciphertext> decoded,
+        DecodeCiphertexts(group, 2 * serialized.size(), [&](size_t i) -> const ElGamalCiphertext& {
+            const auto& elgamal = serialized[i / 2].elgamal();
+            return i % 2 == 0 ? elgamal.element() : elgamal.payload();
+        })
+    );
+
+    std::vector<CiphertextAndElGamal> ciphertexts;
+    ciphertexts.reserve(serialized.size());
+    for (size_t i = 0; i + 1 < decoded.size(); i += 2) {
         ciphertexts.push_back(std::make_pair(
-            std::move(ciphertext), std::move(payload)
+            std::move(decoded[i]), std::move(decoded[i + 1])
         ));
     }
     return ciphertexts;
@@ -92,7 +154,7 @@ StatusOr<std::vector<CiphertextAndElGamal>> DeserializeCiphertexts(
 
 template<>
 StatusOr<std::vector<CiphertextAndPaillier>> DeserializeCiphertexts(
-    const google::protobuf::RepeatedPtrField<EncryptedElement> serialized,
+    const google::protobuf::RepeatedPtrField<EncryptedElement>& serialized,
     Context* ctx,
     ECGroup* group
 ) {
@@ -120,7 +182,7 @@ StatusOr<std::vector<CiphertextAndPaillier>> DeserializeCiphertexts(
 
 template<>
 StatusOr<std::vector<BigNum>> DeserializeCiphertexts(
-    const google::protobuf::RepeatedPtrField<EncryptedElement> serialized,
+    const google::protobuf::RepeatedPtrField<EncryptedElement>& serialized,
     Context* ctx,
     ECGroup* group
 ) {
@@ -163,9 +225,8 @@ BinaryHash computeBinaryHash(T &elem) {
 
 template<>
 BinaryHash computeBinaryHash(Element &elem) {
-	Context ctx;
     return Byte2Binary(
-        ctx.Sha256String(elem.ToBytes())
+        ContextPool::Get()->Sha256String(elem.ToBytes())
     );
 }
 
@@ -180,6 +241,28 @@ BinaryHash computeBinaryHash(Ciphertext &elem) {
     throw std::runtime_error("[Utils] trying to hash a ciphertext");
 }
 
+template<>
+std::vector<BinaryHash> computeBinaryHashes(std::vector<Element> &elems) {
+    std::vector<std::string> bytes;
+    bytes.reserve(elems.size());
+    for (const Element& elem : elems) { bytes.push_back(elem.ToBytes()); }
+
+    std::vector<BinaryHash> hashes = ContextPool::Get()->Sha256Batch(bytes);
+    for (BinaryHash& hash : hashes) { hash = Byte2Binary(hash); }
+    return hashes;
+}
+
+template<>
+std::vector<BinaryHash> computeBinaryHashes(std::vector<ElementAndPayload> &elems) {
+    std::vector<std::string> bytes;
+    bytes.reserve(elems.size());
+    for (const ElementAndPayload& elem : elems) { bytes.push_back(elem.first.ToBytes()); }
+
+    std::vector<BinaryHash> hashes = ContextPool::Get()->Sha256Batch(bytes);
+    for (BinaryHash& hash : hashes) { hash = Byte2Binary(hash); }
+    return hashes;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // ELEMENT COPY
 ////////////////////////////////////////////////////////////////////////////////
@@ -223,16 +306,13 @@ PaillierPair elementCopy(const PaillierPair& elem) {
 
 // generate random binary hash
 BinaryHash generateRandomHash() {
-	Context ctx;
-	std::string random_bytes = ctx.GenerateRandomBytes(32); // 32 bytes for SHA256 => obtain random_path as a byte string
-	return random_bytes;
+	return ContextPool::GetDrbg()->GenerateBytes(32); // 32 bytes for SHA256 => obtain random_path as a byte string
 }
 
 // generate random binary hash for cnt paths
 void generateRandomHash(int cnt, std::vector<std::string> &hsh) {
-	for (int i = 0; i < cnt; ++i) {
-		hsh.push_back(generateRandomHash());
-	}
+	std::vector<std::string> paths = ContextPool::GetDrbg()->GenerateHashes(cnt);
+	hsh.insert(hsh.end(), std::make_move_iterator(paths.begin()), std::make_move_iterator(paths.end()));
 }
 
 StatusOr<elgamal::Ciphertext> elgamalEncrypt(const ECGroup* ec_group, std::unique_ptr<elgamal::PublicKey> public_key, const BigNum& elem) {
@@ -261,9 +341,9 @@ std::string GetRandomNumericString(size_t length, bool padding) {
     } else {
 		absl::StrAppend(&output, "0");
     }
+	Drbg* drbg = ContextPool::GetDrbg();
 	for (size_t i = 1; i < length; i++) {
-		std::string next_char(1, rand() % 10 + '0');
-		absl::StrAppend(&output, next_char);
+		output.push_back('0' + drbg->GenerateUint64LessThan(10));
 	}
 	return output;
 }
@@ -273,9 +353,11 @@ std::string GetRandomSetElement() {
 }
 
 Element GetRandomPadElement(Context* ctx) {
-    return ctx->CreateBigNum(NumericString2uint(
-        GetRandomNumericString(ELEMENT_STR_LENGTH, true)
-    ));
+    // same distribution as parsing GetRandomNumericString(ELEMENT_STR_LENGTH, true)
+    // (a 1 followed by random digits) without building the string
+    uint64_t base = 1;
+    for (int i = 1; i < ELEMENT_STR_LENGTH; i++) { base *= 10; }
+    return ctx->CreateBigNum(base + ContextPool::GetDrbg()->GenerateUint64LessThan(base));
 }
 
 Timer::Timer(std::string msg, std::string color) : message(msg), color(color) {
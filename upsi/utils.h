@@ -35,11 +35,22 @@
 namespace upsi {
 
     #define CURVE_ID NID_X9_62_prime256v1
+    #define HASH_TO_CURVE_DST "upsi-original-hash-to-curve"
 	#define DEFAULT_NODE_SIZE 4
     #define DEFAULT_STASH_SIZE 89
 
     #define MAX_SUM 50000
 
+    // days of offline work (own tree update & encryptions) each party zero
+    // prepares ahead of the day the protocol is on
+    #define PIPELINE_DAYS 1
+
+    // deletion outputs packed into shared paillier plaintexts: each value
+    // must satisfy |value| < 2^(PACKED_VALUE_BITS - 1) and is masked with
+    // PACKED_STAT_BITS bits of statistical security
+    #define PACKED_VALUE_BITS 64
+    #define PACKED_STAT_BITS 40
+
     #define ELEMENT_STR_LENGTH 16
 
 	#define DEBUG 1
@@ -75,12 +86,17 @@ namespace upsi {
     bool AbslParseFlag(absl::string_view text, Functionality* func, std::string* err);
     std::string AbslUnparseFlag(Functionality func);
 
+    // maps between curve names used on the command line ("P-256", "P-384",
+    // ...) and OpenSSL curve ids; secp256k1 is only available with OpenSSL
+    StatusOr<int> CurveIdFromName(absl::string_view name);
+    std::string CurveName(int curve_id);
+
 
 	typedef std::string BinaryHash;
 
     template<typename T>
     StatusOr<std::vector<T>> DeserializeCiphertexts(
-        const google::protobuf::RepeatedPtrField<EncryptedElement> serialized,
+        const google::protobuf::RepeatedPtrField<EncryptedElement>& serialized,
         Context* ctx,
         ECGroup* group
     );
@@ -95,6 +111,21 @@ namespace upsi {
 	template<typename T>
 	BinaryHash computeBinaryHash(T &elem);
 
+	// computeBinaryHash for every element of a node, hashed in one batch
+	template<typename T>
+	std::vector<BinaryHash> computeBinaryHashes(std::vector<T> &elems) {
+		std::vector<BinaryHash> hashes;
+		hashes.reserve(elems.size());
+		for (T &elem : elems) hashes.push_back(computeBinaryHash(elem));
+		return hashes;
+	}
+
+	template<>
+	std::vector<BinaryHash> computeBinaryHashes(std::vector<Element> &elems);
+
+	template<>
+	std::vector<BinaryHash> computeBinaryHashes(std::vector<ElementAndPayload> &elems);
+
 
 	template<typename T>
 	T elementCopy(const T &elem);